@@ -32,6 +32,24 @@
 #include <catch2/catch.hpp>
 #endif
 
+/**
+ * USDT static probes (provider fseam) at the entry and exit of every generated mock method, usable with perf or bpftrace.
+ * Arguments: class name (const char *), method name (const char *), pointer on the call data structure
+ * Enabled with the FSEAM_USE_USDT cmake option, the probes are no-op otherwise.
+ */
+#ifdef FSEAM_USE_USDT
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define FSEAM_PROBE_ENTRY(className, methodName, data) DTRACE_PROBE3(fseam, mock_entry, className, methodName, data)
+#define FSEAM_PROBE_EXIT(className, methodName, data) DTRACE_PROBE3(fseam, mock_exit, className, methodName, data)
+#else
+#error "FSEAM_USE_USDT requires <sys/sdt.h> (systemtap sdt development package)"
+#endif
+#else
+#define FSEAM_PROBE_ENTRY(className, methodName, data) ((void)0)
+#define FSEAM_PROBE_EXIT(className, methodName, data) ((void)0)
+#endif
+
 #include <utility>
 #include <string>
 #include <functional>
@@ -39,7 +57,38 @@
 #include <iostream>
 #include <variant>
 #include <map>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <set>
+#include <tuple>
+#include <algorithm>
+#include <sstream>
 #include <any>
+#include <array>
+#include <optional>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace FSeam {
 
@@ -61,35 +110,40 @@ namespace FSeam {
     struct VerifyCompare {
         explicit VerifyCompare(uint toCompare) : _toCompare(toCompare) {}
         bool compare(uint number) const { return _toCompare == number; }
-        std::string expectStr(uint number) const { return std::string("we expected exactly ") +
-            std::to_string(_toCompare) + std::string(" method call but received ") + std::to_string(number); };
+        std::string expectStr(uint number) const { return describe(_toCompare, number); }
+        static std::string describe(uint toCompare, uint number) { return std::string("we expected exactly ") +
+            std::to_string(toCompare) + std::string(" method call but received ") + std::to_string(number); };
         int _toCompare = 0;
     };
     struct NeverCalled {
         bool compare(uint number) const { return !number; }
-        std::string expectStr(uint number) const { return std::string("we expected this method to never be called ") +
-            std::to_string(_toCompare) + std::string(" but received ") + std::to_string(number); };
+        std::string expectStr(uint number) const { return describe(_toCompare, number); }
+        static std::string describe(uint toCompare, uint number) { return std::string("we expected this method to never be called ") +
+            std::to_string(toCompare) + std::string(" but received ") + std::to_string(number); };
         int _toCompare = 0;
     };
     struct AtLeast {
         explicit AtLeast(uint toCompare) : _toCompare(toCompare) {}
         bool compare(uint number) const { return _toCompare <= number; }
-        std::string expectStr(uint number) { return std::string("we expected at least ") +
-            std::to_string(_toCompare) + std::string(" method call but received ") + std::to_string(number); };
+        std::string expectStr(uint number) const { return describe(_toCompare, number); }
+        static std::string describe(uint toCompare, uint number) { return std::string("we expected at least ") +
+            std::to_string(toCompare) + std::string(" method call but received ") + std::to_string(number); };
         uint _toCompare = 0;
     };
     struct AtMost {
         explicit AtMost(uint toCompare) : _toCompare(toCompare) {}
         bool compare(uint number) const { return _toCompare >= number; }
-        std::string expectStr(uint number) { return std::string("we expected at most ") +
-            std::to_string(_toCompare) + std::string(" method call but received ") + std::to_string(number); };
+        std::string expectStr(uint number) const { return describe(_toCompare, number); }
+        static std::string describe(uint toCompare, uint number) { return std::string("we expected at most ") +
+            std::to_string(toCompare) + std::string(" method call but received ") + std::to_string(number); };
         uint _toCompare = 0;
     };
     struct IsNot {
         explicit IsNot(uint toCompare) : _toCompare(toCompare) {}
         bool compare(uint number) const { return _toCompare != number; }
-        std::string expectStr(uint number) { return std::string("we expected other value than ") +
-            std::to_string(_toCompare) + std::string(" method call but received ") + std::to_string(number); };
+        std::string expectStr(uint number) const { return describe(_toCompare, number); }
+        static std::string describe(uint toCompare, uint number) { return std::string("we expected other value than ") +
+            std::to_string(toCompare) + std::string(" method call but received ") + std::to_string(number); };
         uint _toCompare = 0;
     };
 
@@ -208,9 +262,66 @@ namespace FSeam {
             ERROR
         };
 
+        /**
+         * @brief Structured record of a failed verify, the message is only built when the failure is reported
+         * @note describe is the static describe function of the comparator used in the verify (AtLeast::describe...), the
+         *       verifies that don't check a call count (budgets, call analysis) give their message already formatted
+         */
+        struct VerifyFailure {
+            std::string format() const {
+                if (!describe)
+                    return message;
+                if (neverCalled)
+                    return "Verify error for method " + key + ", method never have been called while " +
+                            describe(expected, 0u) + " method call \n";
+                return "Verify error for method " + key + ", method has been called but " +
+                        describe(expected, received) + " method call \n";
+            }
+
+            std::string key;
+            std::string (*describe)(uint, uint) = nullptr;
+            uint expected = 0;
+            uint received = 0;
+            bool neverCalled = false;
+            std::string message {};
+        };
+
+        /**
+         * @brief Bounded storage of the verify failures, failures recorded once the buffer is full are only counted
+         */
+        class FailureBuffer {
+        public:
+            explicit FailureBuffer(std::size_t capacity = 256) : _capacity(capacity) {}
+
+            void push(VerifyFailure &&failure) {
+                if (_records.size() >= _capacity) {
+                    ++_dropped;
+                    return;
+                }
+                _records.emplace_back(std::move(failure));
+            }
+
+            void clear() {
+                _records.clear();
+                _dropped = 0;
+            }
+
+            bool empty() const { return _records.empty() && !_dropped; }
+            std::size_t size() const { return _records.size(); }
+            std::size_t dropped() const { return _dropped; }
+            std::size_t capacity() const { return _capacity; }
+            const std::vector<VerifyFailure> &records() const { return _records; }
+
+        private:
+            std::size_t _capacity;
+            std::size_t _dropped = 0;
+            std::vector<VerifyFailure> _records;
+        };
+
         struct Logger {
 
             inline static bool customEnabled = false;
+            inline static bool bufferedEnabled = false;
 
             static std::function<void(Level, const std::string &)> &custom(
                     std::optional<std::function<void(Level, const std::string &)> > logging = std::nullopt) {
@@ -248,357 +359,4023 @@ namespace FSeam {
                     custom()(level, msg);
             }
 
-        };
-    }
+            /**
+             * @brief Enable (or disable) the buffered sink for verify failures
+             * @details When enabled, verify failures are kept as VerifyFailure records in a bounded buffer instead of
+             *          being formatted and logged right away. The buffer is formatted and logged in one go by flush(),
+             *          which is called by MockVerifier::cleanUp() (so once per test case).
+             *
+             * @param enable true to buffer the verify failures, false to log them as soon as they happen (default)
+             * @param capacity maximum number of records kept, failures recorded after that are only counted
+             */
+            static void buffered(bool enable = true, std::size_t capacity = 256) {
+                flush();
+                bufferedEnabled = enable;
+                failures() = FailureBuffer(capacity);
+            }
 
-    /**
-     * @brief basic structure that contains description and usage metadata of a mocked method
-     */
-    template<class... Ts> struct overload : Ts... { using Ts::operator()...; };
-    template<class... Ts> overload(Ts...) -> overload<Ts...>;
+            /**
+             * @return the verify failures recorded and not yet flushed
+             */
+            static const FailureBuffer &pending() {
+                return failures();
+            }
 
-    struct MethodCallVerifier {
-        using CalledCompare = std::variant<IsNot, AtMost, AtLeast, NeverCalled, VerifyCompare>;
+            /**
+             * @brief Report a verify failure, logged directly or buffered depending on the buffered flag
+             */
+            static void report(VerifyFailure &&failure) {
+                if (bufferedEnabled)
+                    failures().push(std::move(failure));
+                else
+                    log(Level::ERROR, failure.format());
+            }
 
-        struct Expectation  {
-            bool operator()() {
-                return std::visit(overload {
-                    [this](auto& c) { return c.compare(_numberTimeMatched); }
-                }, _comparator);
+            /**
+             * @brief Report an already formatted verify failure, logged directly or buffered depending on the buffered flag
+             */
+            static void report(std::string key, std::string message) {
+                VerifyFailure failure {};
+
+                failure.key = std::move(key);
+                failure.message = std::move(message);
+                report(std::move(failure));
             }
-            void check(void *data) {
-                if (_expectator(data))
-                    ++_numberTimeMatched;
+
+            /**
+             * @brief Format all the buffered verify failures and log them as a single message
+             */
+            static void flush() {
+                FailureBuffer &buffer = failures();
+
+                if (buffer.empty())
+                    return;
+                std::string msg;
+                for (const auto &failure : buffer.records())
+                    msg += failure.format();
+                if (buffer.dropped())
+                    msg += std::to_string(buffer.dropped()) + " more verify error(s) not recorded (buffer capacity " +
+                            std::to_string(buffer.capacity()) + ")\n";
+                buffer.clear();
+                log(Level::ERROR, msg);
+            }
+
+        private:
+            static FailureBuffer &failures() {
+                static FailureBuffer buffer;
+                return buffer;
             }
-            std::function<bool(void*)> _expectator;
 
-            CalledCompare _comparator;
-            uint _numberTimeMatched = 0;
         };
+    }
 
-        std::string _methodName;
-        std::size_t _called = 0;
-        std::function<void(void*)> _handler;  
-        std::vector<Expectation> _expectations;      
+    /**
+     * @brief Hashing of the mocked methods arguments, used by the call analysis (see FSeam::report)
+     * @details std::hash is used when available for the type, a specialization of ArgHash can be provided for the
+     *          other types (custom structures for example). An argument that can't be hashed disable the analysis
+     *          for the call.
+     *
+     * @example
+     * @code
+     * template <> struct FSeam::ArgHash<source::StructTest> {
+     *      static constexpr bool hashable = true;
+     *      static std::size_t hash(const source::StructTest &s) { return std::hash<std::string>{}(s.testStr); }
+     * };
+     * @endcode
+     */
+    template <typename T, typename = void>
+    struct ArgHash {
+        static constexpr bool hashable = false;
+        static std::size_t hash(const T &) { return 0; }
+    };
+    template <typename T>
+    struct ArgHash<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>()))> > {
+        static constexpr bool hashable = true;
+        static std::size_t hash(const T &value) { return std::hash<T>{}(value); }
     };
 
     /**
-     * @brief Mocking class, it contains all mocked method / save all calls to methods
-     * @details A mock verifier instance class is a class that acknowledge all utilisation (method calls) of the mocked class
-     *          this class also contains the mocked method (dupped).
-     * @todo improve the mocking class to take the arguments and compare them in a verify
+     * @brief Payload size of the mocked methods arguments and return values, used by the payload analysis (see
+     *        FSeam::report::enablePayload)
+     * @details The size of the content is used for the contiguous containers (std::string, std::vector, std::array,
+     *          spans...), sizeof for the other types. A specialization of PayloadSize can be provided for the custom
+     *          structures, to count the content they own (the serialized size for instance).
+     *
+     * @example
+     * @code
+     * template <> struct FSeam::PayloadSize<source::StructTest> {
+     *      static std::size_t size(const source::StructTest &s) { return 2 * sizeof(int) + s.testStr.size(); }
+     * };
+     * @endcode
      */
-    class MockClassVerifier {
-    public:
-        explicit MockClassVerifier(std::string className) : _className(std::move(className)) {}
+    template <typename T, typename = void>
+    struct PayloadSize {
+        static std::size_t size(const T &) { return sizeof(T); }
+    };
+    template <typename T>
+    struct PayloadSize<T, std::void_t<typename T::value_type, decltype(std::declval<const T &>().data()), decltype(std::declval<const T &>().size())> > {
+        static std::size_t size(const T &value) { return value.size() * sizeof(typename T::value_type); }
+    };
 
-        /**
-         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
-         */
-        void invokeDupedMethod(const std::string &methodName, void *arg = nullptr) {
-            std::string key = _className + methodName;
+    namespace report::internal {
+        template <typename T, typename = void>
+        struct is_printable : std::false_type {};
+        template <typename T>
+        struct is_printable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())> > : std::true_type {};
 
-            if (_verifiers.find(key) != _verifiers.end()) {
-                if (auto dupedMethod = _verifiers.at(key)->_handler; dupedMethod)
-                    dupedMethod(arg);
-            }
+        inline void hashCombine(std::size_t &seed, std::size_t value) {
+            seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6u) + (seed >> 2u);
         }
 
         /**
-         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @return the combined hash of the arguments, std::nullopt if one of them isn't hashable
          */
-        void methodCall(std::string methodName, void *data) {
-            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
-            std::string key = _className + methodName;
-
-            if (_verifiers.find(key) != _verifiers.end())
-                methodCallVerifier = _verifiers.at(key);
-            else 
-                methodCallVerifier = std::make_shared<MethodCallVerifier>();
-            for (auto &expectation : methodCallVerifier->_expectations)
-                expectation.check(data);
-            methodCallVerifier->_methodName = std::move(methodName);
-            methodCallVerifier->_called += 1;
-            _verifiers[std::move(key)] = methodCallVerifier;
+        template <typename ...Args>
+        std::optional<std::size_t> hashArgs(const Args &...args) {
+            if constexpr ((ArgHash<Args>::hashable && ...)) {
+                std::size_t seed = sizeof...(Args);
+                (hashCombine(seed, ArgHash<Args>::hash(args)), ...);
+                return seed;
+            }
+            else
+                return std::nullopt;
         }
 
-        /**
-         * Clear the expectations of the given method, if none provided, all expectation are removed
-         * @param methodName
-         */
-        void clearExpectations(std::optional<std::string> methodName = std::nullopt) {
-            if (methodName) {
-                std::string key = _className + std::move(*methodName);
+        template <typename T>
+        void describeValue(std::ostream &os, const T &value) {
+            if constexpr (is_printable<T>::value)
+                os << value;
+            else
+                os << "<" << sizeof(T) << " bytes>";
+        }
 
-                if (_verifiers.find(key) != _verifiers.end()) {
-                    std::shared_ptr<MethodCallVerifier> &methodCallVerifier = _verifiers.at(key);
-                    methodCallVerifier->_expectations.clear();
-                }
-            }
-            else {
-                for( auto const& [key, val] : _verifiers)
-                    val->_expectations.clear();
-            }
+        template <typename T>
+        std::string describeValue(const T &value) {
+            std::ostringstream oss;
+            describeValue(oss, value);
+            return oss.str();
         }
 
         /**
-         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @return printable representation of the arguments: "(arg1, arg2...)", only the type size is given for the
+         *         non printable arguments
          */
-        void registerExpectation(std::string methodName, MethodCallVerifier::Expectation expectation) {
-            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
-            std::string key = _className + std::move(methodName);
-
-            if (_verifiers.find(key) != _verifiers.end())
-                methodCallVerifier = _verifiers.at(key);
-            else 
-                methodCallVerifier = std::make_shared<MethodCallVerifier>();
-            methodCallVerifier->_expectations.emplace_back(std::move(expectation));
-            _verifiers[std::move(key)] = methodCallVerifier;
+        template <typename ...Args>
+        std::string describeArgs(const Args &...args) {
+            std::ostringstream oss;
+            bool first = true;
+            [[maybe_unused]] auto describe = [&oss, &first](const auto &arg) {
+                oss << (first ? "" : ", ");
+                describeValue(oss, arg);
+                first = false;
+            };
+            oss << "(";
+            (describe(args), ...);
+            oss << ")";
+            return oss.str();
         }
 
         /**
-         * @details Add an expectation on the specified method (template specification on a FSeam generated structure representing
-         *        a specific method for a mocked class).
-         *        It is important to note that a call to verify has to be done in order to check those expectations.
-         * @note Working in a similar way to dupeMethod, it is required that the expectation are set before launching your executions
-         *       as the library is going to check registered expectations at runtime. The verify check at the end is used in order
-         *       to check if the number of occurence.
-         *
-         * @example
-         * @code
-         * class ClassName {
-         * public:
-         *      void functionName(int arg1, int arg2, int arg3);
-         * };
-         *
-         * void test () {
-         *      ClassName instance {};
-         *      auto fseamMock = FSeam::get(&instance);
-         *      // !! No execution here, otherwise it won't be checked by the following expectArg
-         *      fseamMock->expectArg<FSeam::ClassName::functionName>(FSeam::Eq{24}, FSeam::NotEq{55}, FSeam::Any{});
-         *      //.... code that execute functionName at some point
-         *      // verify the method has been called at least once with first arg equal 21, second not equal 55, and third anything
-         *      assert(fseamMock->verify(FSeam::ClassName::functionName::NAME));
-         * }
-         * @endcode
-         *
-         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
-         * @tparam Verifiers could be simple type (in this case the comparator FSeam::Eq is being called) or any Comparator,
-         * @param verifiers comparator used in order to check the arguments of the method identified by ClassMethodIdentifier
-         * @return true if the method has been called at least once, false otherwise
+         * @return payload of the arguments of a mocked call (see FSeam::PayloadSize)
          */
-        template <typename ClassMethodIdentifier, typename ...Verifiers>
-        void expectArg(Verifiers ... verifiers);
+        template <typename ...Args>
+        std::size_t payloadBytes(const Args &...args) {
+            return (std::size_t{0} + ... + PayloadSize<std::decay_t<Args> >::size(args));
+        }
+    }
+
+    namespace report {
 
         /**
-         * @brief Call dupeMethod in order to set the set the correct return value
-         * @note The duping is done in a composed way, calling dupeReturn won't override current dupe
-         * 
-         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
-         * @tparam ReturnType Return type of the function to mock
-         * @param ret return value to return when the mocked method is called
+         * @brief Opt-in analysis enabled on the mocked calls
          */
-        template <typename ClassMethodIdentifier, typename ReturnType>
-        void dupeReturn(ReturnType ret);
+        struct Settings {
+            inline static bool redundantCalls = false;
+            inline static bool chattyCalls = false;
+            inline static bool transitions = false;
+            inline static bool callSites = false;
+            inline static bool sketches = false;
+            inline static bool cacheSimulation = false;
+            inline static bool payload = false;
+            inline static bool concurrency = false;
+        };
 
         /**
-         * @brief This method make it possible to dupe a method in order to have it do what you want.
-         *        This is a low level function that require the user to understand how the generated data struct
-         *        containing the function call metadata works (as this is the argument given to the handler)
-         * @note Duping an existing method doesn't remove the expectations attached to it.
-         *
-         * @param className name of the class to mock
-         * @param methodName method name to dupe
-         * @param handler dupped method that takes the data structure pointer. This data structure is a struct
-         *         that contains all the data for the called method (arguments, return values)
-         * @param isComposed if true, compose a new handler with the current one and the provided one,
-         *         if false, override the existing handler if any. Set at false by default
+         * @brief HyperLogLog distinct count estimator in fixed memory (1024 registers, ~3% standard error)
          */
-        void dupeMethod(std::string methodName, const std::function<void(void*)> &handler, bool isComposed = false) {
-            auto methodCallVerifier = std::make_shared<MethodCallVerifier>();
-            std::string key = _className + methodName;
+        class HyperLogLog {
+        public:
+            static constexpr unsigned PRECISION = 10;
+            static constexpr std::size_t REGISTERS = std::size_t{1} << PRECISION;
 
-            if (_verifiers.find(key) != _verifiers.end())
-                methodCallVerifier = _verifiers.at(key);
-            methodCallVerifier->_methodName = std::move(methodName);
-            if (isComposed && methodCallVerifier->_handler) {
-                methodCallVerifier->_handler = [currentHandler = methodCallVerifier->_handler, handler](void *data){
-                    currentHandler(data);
-                    handler(data);
-                };
+            void add(std::uint64_t hash) {
+                hash = mix(hash);
+                std::size_t index = hash >> (64u - PRECISION);
+                std::uint64_t remaining = hash << PRECISION;
+                auto rank = static_cast<std::uint8_t>(remaining ? __builtin_clzll(remaining) + 1 : 64 - PRECISION + 1);
+                _registers[index] = std::max(_registers[index], rank);
             }
-            else {
-                methodCallVerifier->_called = 0;
-                methodCallVerifier->_handler = handler;
+
+            /**
+             * @return estimated number of distinct values added
+             */
+            double estimate() const {
+                double alpha = 0.7213 / (1. + 1.079 / static_cast<double>(REGISTERS));
+                double sum = 0.;
+                std::size_t zeros = 0;
+
+                for (std::uint8_t rank : _registers) {
+                    sum += std::ldexp(1., -rank);
+                    zeros += rank ? 0 : 1;
+                }
+                double estimate = alpha * static_cast<double>(REGISTERS * REGISTERS) / sum;
+                // small range correction (linear counting)
+                if (estimate <= 2.5 * static_cast<double>(REGISTERS) && zeros)
+                    estimate = static_cast<double>(REGISTERS) * std::log(static_cast<double>(REGISTERS) / static_cast<double>(zeros));
+                return estimate;
             }
-            _verifiers[std::move(key)] = methodCallVerifier;
-        }
 
-        /**
-         * @brief Verify if the given method has been called at least one time
-         * 
-         * @param methodName Name of the method to check on the mock (Use the helpers constant to ensure no typo)
-         * @param verbose flag if a debug string is required in case of false response (set to true by default)
-         * @return true if the method encounter the provided comparator conditions, false otherwise
-         */
-        bool verify(const std::string &methodName, bool verbose = true) const {
-            return verify(methodName, AtLeast(1), verbose);
-        }
+        private:
+            // std::hash of an integer is the identity on libstdc++, the bits have to be mixed (splitmix64 finalizer)
+            static std::uint64_t mix(std::uint64_t x) {
+                x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9ull;
+                x = (x ^ (x >> 27u)) * 0x94d049bb133111ebull;
+                return x ^ (x >> 31u);
+            }
+
+            std::array<std::uint8_t, REGISTERS> _registers {};
+        };
 
         /**
-         * @brief Verify if a method has been called under certain conditions (number of times)
-         * 
-         * @tparam Comparator  comparator class used, can be also an Integer, those comparator are defined under the namespace FSeam,
-         *          VerifyCompare/Integral value : Check if the method has been called exactly the number provided
-         *          NeverCalled : Check if the method has never been called
-         *          AtLeast : Check if the method has been called at least the number provided
-         *          AtMost  : Check if the method has been called at most the number provided
-         *          IsNot   : Check if the method is not the number provided
-         *          
-         * @param methodName Name of the method to check on the mock (Use the helpers constant to ensure no typo)
-         * @param comp comparator instance on which the number of times the mock method is called on a provided value
-         *         is checked against
-         * @param verbose flag if a debug string is required in case of false response (set to true by default)
-         * @return true if the method encounter the provided comparator conditions, false otherwise
+         * @brief Most frequent values in fixed memory (Space-Saving with 16 counters): the count of a value is over
+         *        estimated by at most its error
          */
-        template <typename Comparator>
-        bool verify(std::string methodName, Comparator &&comp, bool verbose = true) const {
-            if constexpr (std::is_integral<Comparator>())
-                return verify(std::move(methodName), VerifyCompare{ static_cast<uint>(comp) }, verbose);
-            else {
-                static_assert(isCalledComparator<Comparator>::v, "Type  should be AtLeast, AtMost, Never, IsNot or VerifyCompare");
-                std::string key = _className + std::move(methodName);
+        class HeavyHitters {
+        public:
+            static constexpr std::size_t CAPACITY = 16;
+            static constexpr std::size_t MAX_DESCRIPTION = 64;
 
-                if (_verifiers.find(key) == _verifiers.end()) {
-                    if (verbose && comp._toCompare > 0u) {
-                        Logging::Logger::log(Logging::Level::ERROR,
-                                "Verify error for method " + key + ", method never have been called while " + comp.expectStr(0u) + " method call \n");
-                    }
-                    return comp._toCompare == 0u;
+            struct Entry {
+                std::uint64_t hash = 0;
+                std::string value;
+                std::size_t count = 0;
+                std::size_t error = 0;
+            };
+
+            template <typename Describe>
+            void add(std::uint64_t hash, Describe &&describe) {
+                auto it = std::find_if(_entries.begin(), _entries.end(), [hash](const Entry &entry) { return entry.hash == hash; });
+
+                if (it != _entries.end()) {
+                    ++it->count;
+                    return;
                 }
-                bool result = comp.compare(_verifiers.at(key)->_called);
-                if (verbose && !result) {
-                    Logging::Logger::log(Logging::Level::ERROR,
-                                         "Verify error for method " + key + ", method has been called but " +
-                                                 comp.expectStr(_verifiers.at(key)->_called) + " method call \n");
+                if (_entries.size() < CAPACITY) {
+                    _entries.push_back(Entry{hash, describe().substr(0, MAX_DESCRIPTION), 1, 0});
+                    return;
                 }
-                for (auto &expect : _verifiers.at(key)->_expectations)
-                    result &= expect();
-                return result;
+                auto min = std::min_element(_entries.begin(), _entries.end(), [](const Entry &lhs, const Entry &rhs) {
+                    return lhs.count < rhs.count;
+                });
+                *min = Entry{hash, describe().substr(0, MAX_DESCRIPTION), min->count + 1, min->count};
             }
-        }
 
-    private:
-        std::string _className;
-        std::map<std::string, std::shared_ptr<MethodCallVerifier> > _verifiers;
-    };
+            /**
+             * @return the topN most frequent values, sorted by decreasing count
+             */
+            std::vector<Entry> top(std::size_t topN = 5) const {
+                std::vector<Entry> entries = _entries;
 
-    /**
-     * @brief Mocking singleton, this is the main class of FSeam class contains all the mock
-     */
-    class MockVerifier {
-        inline static std::unique_ptr<MockVerifier> inst = nullptr;
+                std::stable_sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) { return lhs.count > rhs.count; });
+                if (entries.size() > topN)
+                    entries.resize(topN);
+                return entries;
+            }
 
-    public:
-        MockVerifier() = default;
-        ~MockVerifier() = default;
+        private:
+            std::vector<Entry> _entries;
+        };
 
-        static MockVerifier &instance() {
-            if (inst == nullptr) {
-                inst = std::make_unique<MockVerifier>();
-            };
+        /**
+         * @brief Min / max / mean and power of 2 histogram of the values of an arithmetic parameter
+         */
+        struct Distribution {
+            void add(double value) {
+                min = count ? std::min(min, value) : value;
+                max = count ? std::max(max, value) : value;
+                ++count;
+                sum += value;
+                if (value < 0.)
+                    ++negatives;
+                else
+                    ++buckets[std::min<std::size_t>(value < 1. ? 0 : static_cast<std::size_t>(std::ilogb(value)) + 1, buckets.size() - 1)];
+            }
+            double mean() const { return count ? sum / static_cast<double>(count) : 0.; }
+
+            /**
+             * @return upper bound of the bucket -> number of values, for the non negative values
+             */
+            std::map<double, std::size_t> histogram() const {
+                std::map<double, std::size_t> result;
+
+                for (std::size_t i = 0; i < buckets.size(); ++i) {
+                    if (buckets[i])
+                        result[std::ldexp(1., static_cast<int>(i))] = buckets[i];
+                }
+                return result;
+            }
+
+            std::size_t count = 0;
+            double min = 0.;
+            double max = 0.;
+            double sum = 0.;
+            std::size_t negatives = 0;
+            std::array<std::size_t, 64> buckets {};   // bucket i contains the values in [2^(i-1), 2^i), bucket 0 [0, 1)
+        };
+
+        /**
+         * @brief Sketches of the values of a mocked method parameter
+         */
+        struct ParameterSketch {
+            template <typename T>
+            void observe(const T &value) {
+                ++calls;
+                if constexpr (ArgHash<T>::hashable) {
+                    std::uint64_t hash = ArgHash<T>::hash(value);
+                    distinct.add(hash);
+                    topValues.add(hash, [&value]() { return internal::describeValue(value); });
+                }
+                else
+                    ++unhashed;
+                if constexpr (std::is_arithmetic_v<T>) {
+                    if (!distribution)
+                        distribution.emplace();
+                    distribution->add(static_cast<double>(value));
+                }
+            }
+
+            std::size_t calls = 0;
+            std::size_t unhashed = 0;          // values not sketched into distinct / topValues (no FSeam::ArgHash)
+            HyperLogLog distinct;
+            HeavyHitters topValues;
+            std::optional<Distribution> distribution;   // arithmetic parameters only
+        };
+
+        /**
+         * @brief Sketches of the arguments of a mocked method: the whole argument tuple (the key of a cache in front of
+         *        the method) and each parameter
+         */
+        struct ArgumentSketches {
+            std::string key;
+            std::size_t calls = 0;
+            HyperLogLog distinctTuples;
+            std::vector<ParameterSketch> parameters;
+        };
+
+        /**
+         * @brief Eviction / admission policies of the simulated caches (see MockClassVerifier::simulateCache)
+         */
+        enum CachePolicy : unsigned {
+            LRU = 1u << 0u,        // evict the least recently used key
+            LFU = 1u << 1u,        // evict the least frequently used key (the least recently used among them)
+            TINY_LFU = 1u << 2u,   // LRU eviction, a missed key is admitted only if it is more frequent than the victim
+            ALL_POLICIES = LRU | LFU | TINY_LFU
+        };
+
+        inline std::string cachePolicyName(CachePolicy policy) {
+            switch (policy) {
+                case LRU: return "LRU";
+                case LFU: return "LFU";
+                case TINY_LFU: return "TinyLFU";
+                default: return "Unknown";
+            }
+        }
+
+        /**
+         * @brief Hit ratio curve of a simulated cache policy: one point per simulated capacity
+         */
+        struct CacheCurve {
+            struct Point {
+                double hitRatio() const { return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.; }
+
+                std::size_t capacity = 0;
+                std::size_t lookups = 0;
+                std::size_t hits = 0;
+            };
+
+            CachePolicy policy = LRU;
+            std::vector<Point> points;
+        };
+
+        /**
+         * @brief Result of the replay of the argument tuples of a mocked method through simulated caches, the argument
+         *        tuple being the key of the cache
+         */
+        struct CacheSimulation {
+            /**
+             * @return the curve of the given policy, nullptr if not simulated
+             */
+            const CacheCurve *curve(CachePolicy policy) const {
+                auto it = std::find_if(curves.begin(), curves.end(), [policy](const CacheCurve &c) { return c.policy == policy; });
+                return it != curves.end() ? &(*it) : nullptr;
+            }
+
+            std::string key;
+            std::size_t calls = 0;
+            std::size_t distinct = 0;        // compulsory misses: no cache of any size hits those
+            std::size_t uncacheable = 0;     // calls with arguments not hashable with FSeam::ArgHash (not replayed)
+            std::vector<CacheCurve> curves;
+        };
+
+        /**
+         * @brief Payload volume of a mocked method: bytes passed in as arguments and returned out (see FSeam::PayloadSize)
+         */
+        struct Payload {
+            void passed(std::size_t bytes) {
+                ++calls;
+                bytesIn += bytes;
+                in.add(static_cast<double>(bytes));
+            }
+            void returned(std::size_t bytes) {
+                bytesOut += bytes;
+                out.add(static_cast<double>(bytes));
+            }
+            std::size_t bytes() const { return bytesIn + bytesOut; }
+
+            std::string key;
+            std::size_t calls = 0;
+            std::size_t bytesIn = 0;
+            std::size_t bytesOut = 0;
+            Distribution in;    // bytes per call (histogram of the argument payloads)
+            Distribution out;   // bytes per call returning a value
+        };
+
+        /**
+         * @brief Concurrency of the calls to a mocked method, from the entry and exit timestamps of each call
+         */
+        struct Concurrency {
+            std::string key;
+            std::size_t calls = 0;
+            std::size_t maxInFlight = 0;                                                  // calls in flight at the same time
+            std::size_t overlappedCalls = 0;                                              // calls started while another one was in flight
+            std::chrono::nanoseconds concurrentTime = std::chrono::nanoseconds::zero();   // time with at least 2 calls in flight
+        };
+
+        namespace internal {
+
+            class SimulatedLru {
+            public:
+                explicit SimulatedLru(std::size_t capacity) : _capacity(capacity) {}
+
+                bool access(std::uint64_t key) {
+                    if (touch(key))
+                        return true;
+                    if (_capacity && _entries.size() >= _capacity)
+                        evict();
+                    insert(key);
+                    return false;
+                }
+
+                bool touch(std::uint64_t key) {
+                    auto it = _entries.find(key);
+
+                    if (it == _entries.end())
+                        return false;
+                    _order.splice(_order.begin(), _order, it->second);
+                    return true;
+                }
+                bool empty() const { return _entries.empty(); }
+                bool full() const { return _entries.size() >= _capacity; }
+                std::uint64_t victim() const { return _order.back(); }
+                void evict() {
+                    _entries.erase(_order.back());
+                    _order.pop_back();
+                }
+                void insert(std::uint64_t key) {
+                    if (!_capacity)
+                        return;
+                    _order.push_front(key);
+                    _entries[key] = _order.begin();
+                }
+
+            private:
+                std::size_t _capacity;
+                std::list<std::uint64_t> _order;
+                std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator> _entries;
+            };
+
+            class SimulatedLfu {
+            public:
+                explicit SimulatedLfu(std::size_t capacity) : _capacity(capacity) {}
+
+                bool access(std::uint64_t key) {
+                    ++_tick;
+                    if (auto it = _entries.find(key); it != _entries.end()) {
+                        _order.erase({it->second.first, it->second.second, key});
+                        it->second = {it->second.first + 1, _tick};
+                        _order.insert({it->second.first, it->second.second, key});
+                        return true;
+                    }
+                    if (!_capacity)
+                        return false;
+                    if (_entries.size() >= _capacity) {
+                        _entries.erase(std::get<2>(*_order.begin()));
+                        _order.erase(_order.begin());
+                    }
+                    _entries[key] = {1, _tick};
+                    _order.insert({1, _tick, key});
+                    return false;
+                }
+
+            private:
+                std::size_t _capacity;
+                std::size_t _tick = 0;
+                std::unordered_map<std::uint64_t, std::pair<std::size_t, std::size_t> > _entries; // key -> frequency, last access
+                std::set<std::tuple<std::size_t, std::size_t, std::uint64_t> > _order;
+            };
+
+            /**
+             * @brief LRU cache with a TinyLFU admission filter: the access frequencies are kept in a count-min sketch
+             *        (4 rows of 4 bit counters, halved every 10 * capacity accesses so that old popularity fades)
+             */
+            class SimulatedTinyLfu {
+            public:
+                explicit SimulatedTinyLfu(std::size_t capacity) : _lru(capacity), _sampleSize(10 * std::max<std::size_t>(capacity, 1)) {
+                    std::size_t width = 16;
+                    while (width < 4 * capacity)
+                        width <<= 1u;
+                    _counters.assign(4 * width, 0);
+                    _mask = width - 1;
+                }
+
+                bool access(std::uint64_t key) {
+                    increment(key);
+                    if (_lru.touch(key))
+                        return true;
+                    if (!_lru.full())
+                        _lru.insert(key);
+                    else if (!_lru.empty() && frequency(key) > frequency(_lru.victim())) {
+                        _lru.evict();
+                        _lru.insert(key);
+                    }
+                    return false;
+                }
+
+            private:
+                std::size_t index(std::uint64_t key, std::size_t row) const {
+                    std::uint64_t hash = (key + row) * 0x9e3779b97f4a7c15ull;
+                    return row * (_mask + 1) + ((hash ^ (hash >> 32u)) & _mask);
+                }
+                std::uint8_t frequency(std::uint64_t key) const {
+                    std::uint8_t result = 15;
+                    for (std::size_t row = 0; row < 4; ++row)
+                        result = std::min(result, _counters[index(key, row)]);
+                    return result;
+                }
+                void increment(std::uint64_t key) {
+                    for (std::size_t row = 0; row < 4; ++row) {
+                        std::uint8_t &counter = _counters[index(key, row)];
+                        counter = std::min<std::uint8_t>(counter + 1, 15);
+                    }
+                    if (++_additions >= _sampleSize) {
+                        for (std::uint8_t &counter : _counters)
+                            counter >>= 1u;
+                        _additions /= 2;
+                    }
+                }
+
+                SimulatedLru _lru;
+                std::vector<std::uint8_t> _counters;
+                std::size_t _mask = 0;
+                std::size_t _sampleSize;
+                std::size_t _additions = 0;
+            };
+
+            /**
+             * @brief Replay a key stream through every (policy, capacity) cache in a single pass
+             */
+            inline std::vector<CacheCurve> simulateCaches(const std::vector<std::uint64_t> &keys, unsigned policies,
+                                                          const std::vector<std::size_t> &capacities) {
+                std::vector<CacheCurve> curves;
+                std::vector<std::function<bool(std::uint64_t)> > caches;
+
+                for (CachePolicy policy : {LRU, LFU, TINY_LFU}) {
+                    if (!(policies & policy))
+                        continue;
+                    curves.push_back(CacheCurve{policy, {}});
+                    for (std::size_t capacity : capacities) {
+                        curves.back().points.push_back(CacheCurve::Point{capacity, keys.size(), 0});
+                        if (policy == LRU)
+                            caches.emplace_back([cache = std::make_shared<SimulatedLru>(capacity)](std::uint64_t key) { return cache->access(key); });
+                        else if (policy == LFU)
+                            caches.emplace_back([cache = std::make_shared<SimulatedLfu>(capacity)](std::uint64_t key) { return cache->access(key); });
+                        else
+                            caches.emplace_back([cache = std::make_shared<SimulatedTinyLfu>(capacity)](std::uint64_t key) { return cache->access(key); });
+                    }
+                }
+                std::vector<std::size_t> hits(caches.size(), 0);
+                for (std::uint64_t key : keys) {
+                    for (std::size_t i = 0; i < caches.size(); ++i)
+                        hits[i] += caches[i](key) ? 1 : 0;
+                }
+                std::size_t i = 0;
+                for (CacheCurve &curve : curves) {
+                    for (CacheCurve::Point &point : curve.points)
+                        point.hits = hits[i++];
+                }
+                return curves;
+            }
+
+        }
+
+
+        /**
+         * @brief Redundant call report of a mocked method: number of calls done with arguments already seen
+         */
+        struct RedundantCall {
+            double duplicateRatio() const {
+                return calls ? static_cast<double>(calls - distinct) / static_cast<double>(calls) : 0.;
+            }
+
+            std::string key;
+            std::size_t calls = 0;
+            std::size_t distinct = 0;
+            std::size_t unhashedCalls = 0;
+            std::vector<std::pair<std::string, std::size_t> > topTuples;
+        };
+
+        /**
+         * @brief Chatty call report of a mocked method: runs of consecutive calls to the method with varying arguments
+         *        without any other mocked call in between (N+1 / missed batching pattern)
+         * @note the runs made of calls with the same arguments are not chatty (a batched API wouldn't help, see the
+         *       redundant call analysis), they are only given in identicalRuns
+         */
+        struct ChattyCall {
+            std::string key;
+            std::size_t calls = 0;  // all the calls, identical runs included
+            std::size_t runs = 0;
+            std::size_t maxRun = 0;
+            std::map<std::size_t, std::size_t> runLengths;    // run length -> number of runs with varying arguments
+            std::map<std::size_t, std::size_t> identicalRuns; // run length -> number of runs with the same arguments
+        };
+
+        /**
+         * @brief Spy call report of a spied method: time spent into the original implementation
+         */
+        struct SpyCall {
+            std::chrono::nanoseconds mean() const {
+                return calls ? total / static_cast<std::chrono::nanoseconds::rep>(calls) : std::chrono::nanoseconds::zero();
+            }
+
+            std::string key;
+            std::size_t calls = 0;
+            std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+        };
+
+        /**
+         * @brief Call site report of a mocked method: number of calls done from a return address of the code under test
+         * @details The return address is resolved into the module (executable or shared library) containing it and the
+         *          offset into this module, which is what addr2line expects (see Generator/FSeamCallSites.py)
+         */
+        struct CallSite {
+            std::string location() const {
+                std::ostringstream os;
+                os << module << "+0x" << std::hex << offset;
+                return os.str();
+            }
+
+            std::string key;
+            const void *address = nullptr;
+            std::size_t calls = 0;
+            std::string module;
+            std::uintptr_t offset = 0;
+        };
+
+        /**
+         * @brief Transition report: time spent into the code under test between the exit of a mocked method (from)
+         *        and the entry of the next mocked method called on the same thread (to)
+         */
+        struct Transition {
+            void record(std::chrono::nanoseconds elapsed) {
+                std::size_t upperBound = 1;
+
+                while (upperBound < static_cast<std::size_t>(elapsed.count()))
+                    upperBound <<= 1u;
+                ++buckets[upperBound];
+                min = calls ? std::min(min, elapsed) : elapsed;
+                max = std::max(max, elapsed);
+                total += elapsed;
+                ++calls;
+            }
+
+            std::chrono::nanoseconds mean() const {
+                return calls ? total / static_cast<std::chrono::nanoseconds::rep>(calls) : std::chrono::nanoseconds::zero();
+            }
+
+            /**
+             * @return upper bound of the histogram bucket containing the given percentile (between 0 and 1)
+             */
+            std::chrono::nanoseconds percentile(double p) const {
+                std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(calls)));
+                std::size_t seen = 0;
+
+                for (const auto &[upperBound, count] : buckets) {
+                    seen += count;
+                    if (seen >= rank)
+                        return std::min(max, std::chrono::nanoseconds(upperBound));
+                }
+                return max;
+            }
+
+            std::string from;
+            std::string to;
+            std::size_t calls = 0;
+            std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds min = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+            std::map<std::size_t, std::size_t> buckets; // upper bound in ns (power of 2) -> number of transitions
+        };
+
+    }
+
+    namespace report::internal {
+
+        /**
+         * @brief Timestamp the entry and exit of the mocked calls in order to build the transition reports
+         * @note the last exit is kept per thread, the transitions are shared between threads
+         */
+        class TransitionTracker {
+            struct Exit {
+                std::size_t generation;
+                std::string key;
+                std::chrono::steady_clock::time_point time;
+            };
+
+        public:
+            static void entry(const std::string &key) {
+                auto now = std::chrono::steady_clock::now();
+
+                if (!_last || _last->generation != _generation)
+                    return;
+                std::lock_guard<std::mutex> lock(_mutex);
+                Transition &transition = _transitions[{_last->key, key}];
+                if (!transition.calls) {
+                    transition.from = _last->key;
+                    transition.to = key;
+                }
+                transition.record(now - _last->time);
+            }
+
+            static void exit(std::string key) {
+                _last = Exit{_generation, std::move(key), std::chrono::steady_clock::now()};
+            }
+
+            static void reset() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _transitions.clear();
+                ++_generation;
+            }
+
+            static std::vector<Transition> transitions() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                std::vector<Transition> result;
+
+                for (const auto &[fromTo, transition] : _transitions)
+                    result.emplace_back(transition);
+                return result;
+            }
+
+        private:
+            inline static std::mutex _mutex;
+            inline static std::map<std::pair<std::string, std::string>, Transition> _transitions;
+            inline static std::atomic<std::size_t> _generation = 0;
+            inline static thread_local std::optional<Exit> _last;
+        };
+
+    }
+
+    /**
+     * @brief Latency distributions used to inject delays into mocked methods (see MockClassVerifier::dupeLatency)
+     * @note Sampling is done with a per thread PRNG seeded from Latency::setSeed, a run is reproducible as long as the
+     *       threads calling the mocked methods are started in the same order
+     */
+    namespace Latency {
+
+        struct Fixed {
+            std::chrono::nanoseconds sample(std::mt19937_64 &) const { return _delay; }
+            std::chrono::nanoseconds _delay;
+        };
+
+        /**
+         * @brief Uniform distribution between min and max (both included)
+         * @throw std::invalid_argument if min is negative or greater than max
+         */
+        struct Uniform {
+            Uniform(std::chrono::nanoseconds min, std::chrono::nanoseconds max) : _min(min), _max(max) {
+                if (_min.count() < 0 || _min > _max)
+                    throw std::invalid_argument("FSeam::Latency::Uniform requires 0 <= min <= max");
+            }
+
+            std::chrono::nanoseconds sample(std::mt19937_64 &prng) const {
+                return std::chrono::nanoseconds(std::uniform_int_distribution<std::chrono::nanoseconds::rep>(_min.count(), _max.count())(prng));
+            }
+            std::chrono::nanoseconds _min;
+            std::chrono::nanoseconds _max;
+        };
+
+        /**
+         * @brief Log-normal distribution defined by its median and the standard deviation of the underlying normal distribution
+         * @throw std::invalid_argument if the median or the standard deviation isn't strictly positive
+         */
+        struct LogNormal {
+            LogNormal(std::chrono::nanoseconds median, double sigma = 0.5) : _median(median), _sigma(sigma) {
+                if (_median.count() <= 0 || !(_sigma > 0.))
+                    throw std::invalid_argument("FSeam::Latency::LogNormal requires a strictly positive median and sigma");
+            }
+
+            std::chrono::nanoseconds sample(std::mt19937_64 &prng) const {
+                double delay = std::lognormal_distribution<double>(std::log(static_cast<double>(_median.count())), _sigma)(prng);
+                return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(delay));
+            }
+            std::chrono::nanoseconds _median;
+            double _sigma;
+        };
+
+        /**
+         * @brief Empirical distribution from an histogram: a bucket is picked depending on its weight, the delay is then
+         *        uniformly sampled between the upper bound of the previous bucket and the upper bound of the picked one
+         * @note the cumulative weights are computed once at construction, a sample is a binary search into them
+         * @throw std::invalid_argument if there is no bucket, if the upper bounds aren't ascending (the first one being
+         *        positive or null), if a weight is negative or if no weight is strictly positive
+         */
+        struct Empirical {
+            struct Bucket {
+                std::chrono::nanoseconds _upperBound;
+                double _weight;
+            };
+
+            Empirical(std::vector<Bucket> buckets) : _buckets(std::move(buckets)) {
+                double total = 0.;
+                std::chrono::nanoseconds lowerBound {0};
+                for (const auto &bucket : _buckets) {
+                    if (bucket._upperBound < lowerBound || (&bucket != &_buckets.front() && bucket._upperBound == lowerBound))
+                        throw std::invalid_argument("FSeam::Latency::Empirical requires ascending bucket upper bounds");
+                    if (!(bucket._weight >= 0.))
+                        throw std::invalid_argument("FSeam::Latency::Empirical requires positive bucket weights");
+                    lowerBound = bucket._upperBound;
+                    _cumulativeWeights.emplace_back(total += bucket._weight);
+                }
+                if (!(total > 0.))
+                    throw std::invalid_argument("FSeam::Latency::Empirical requires at least a bucket with a strictly positive weight");
+            }
+
+            std::chrono::nanoseconds sample(std::mt19937_64 &prng) const {
+                double picked = std::uniform_real_distribution<double>(0., _cumulativeWeights.back())(prng);
+                auto it = std::upper_bound(_cumulativeWeights.begin(), _cumulativeWeights.end(), picked);
+                std::size_t index = std::min(static_cast<std::size_t>(it - _cumulativeWeights.begin()), _buckets.size() - 1);
+                std::chrono::nanoseconds lowerBound = index ? _buckets[index - 1]._upperBound : std::chrono::nanoseconds(0);
+                return Uniform{lowerBound, _buckets[index]._upperBound}.sample(prng);
+            }
+            std::vector<Bucket> _buckets;
+            std::vector<double> _cumulativeWeights;
+        };
+
+        using Distribution = std::variant<Fixed, Uniform, LogNormal, Empirical>;
+
+        namespace internal {
+            inline std::atomic<std::uint64_t> seed {5489u};
+            inline std::atomic<std::uint64_t> seedGeneration {0};
+            inline std::atomic<std::uint64_t> threadCount {0};
+        }
+
+        /**
+         * @brief Set the seed of the latency PRNG, the PRNG of each thread is re-seeded from it
+         */
+        inline void setSeed(std::uint64_t seed) {
+            internal::seed = seed;
+            ++internal::seedGeneration;
+            internal::threadCount = 0;
+        }
+
+        /**
+         * @return PRNG of the current thread
+         */
+        inline std::mt19937_64 &prng() {
+            thread_local std::mt19937_64 engine;
+            thread_local std::uint64_t generation = ~0ull;
+
+            if (generation != internal::seedGeneration) {
+                generation = internal::seedGeneration;
+                std::seed_seq seq {internal::seed.load(), internal::threadCount++};
+                engine.seed(seq);
+            }
+            return engine;
+        }
+
+        inline std::chrono::nanoseconds sample(const Distribution &distribution) {
+            return std::visit([](const auto &d) { return d.sample(prng()); }, distribution);
+        }
+
+        /**
+         * @brief Set the way the sampled delay is applied, by default the calling thread sleep for the delay
+         * @param wait function applying the delay (advance a test clock for instance), an empty function to reset the
+         *        default (sleep). Without argument (std::nullopt), the current delayer is left unchanged
+         * @return the current delayer (empty if the calling thread sleeps)
+         */
+        inline std::function<void(std::chrono::nanoseconds)> &onDelay(
+                std::optional<std::function<void(std::chrono::nanoseconds)> > wait = std::nullopt) {
+            static std::function<void(std::chrono::nanoseconds)> delayer;
+
+            if (wait)
+                delayer = std::move(*wait);
+            return delayer;
+        }
+
+        inline void delay(std::chrono::nanoseconds delay) {
+            if (auto &delayer = onDelay(); delayer)
+                delayer(delay);
+            else
+                std::this_thread::sleep_for(delay);
+        }
+
+    }
+
+    /**
+     * @brief Virtual clock used by the clock seam (seams/clock.cc, linked with addFSeamTests(... SEAMS clock))
+     * @details When enabled, clock_gettime (so std::chrono::steady_clock::now and system_clock::now), nanosleep and
+     *          clock_nanosleep (so std::this_thread::sleep_for and sleep_until) are using this clock. Sleeping doesn't
+     *          block, it advances the virtual clock by the requested duration.
+     *          When disabled (default), the seam forwards to the real clock.
+     */
+    namespace Clock {
+
+        namespace internal {
+            inline std::atomic<bool> enabled {false};
+            inline std::atomic<std::int64_t> steady {0};
+            inline std::atomic<std::int64_t> systemOffset {0};
+        }
+
+        inline bool isEnabled() {
+            return internal::enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Enable the virtual clock, it starts at the current real time and then only moves when advanced
+         */
+        inline void enable(bool enable = true) {
+            if (enable && !isEnabled()) {
+                std::int64_t steady = std::chrono::steady_clock::now().time_since_epoch().count();
+                std::int64_t system = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                internal::steady = steady;
+                internal::systemOffset = system - steady;
+            }
+            internal::enabled = enable;
+        }
+
+        inline void advance(std::chrono::nanoseconds duration) {
+            if (duration.count() > 0)
+                internal::steady += duration.count();
+        }
+
+        /**
+         * @brief Set the wall clock time (system_clock), the steady clock isn't modified
+         */
+        inline void setSystemTime(std::chrono::system_clock::time_point time) {
+            internal::systemOffset = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count() - internal::steady;
+        }
+
+        inline std::chrono::nanoseconds steadyNow() {
+            return std::chrono::nanoseconds(internal::steady.load());
+        }
+
+        inline std::chrono::nanoseconds systemNow() {
+            return std::chrono::nanoseconds(internal::steady.load() + internal::systemOffset.load());
+        }
+
+    }
+
+    /**
+     * @brief Discrete-event queueing model of the mocked dependencies: each modeled mocked method is a server with a
+     *        service time distribution and a concurrency limit, called by N logical clients running the code under test
+     * @details The clients are threads run one at a time on a virtual time line (each client has its own clock, the
+     *          client with the earliest clock always runs next): a call to a modeled method arrives at the client time,
+     *          waits for the first free slot of the server (FIFO), is served and the client time moves to the end of
+     *          the service. The run is deterministic for a given seed. When the virtual clock (FSeam::Clock) is enabled
+     *          it follows the time of the running client, the sleeps of the code under test are then part of the model.
+     * @note The clients must not wait on each other (a lock held across a modeled call for instance), as only one of
+     *       them runs at a time.
+     *
+     * @example
+     * @code
+     * FSeam::Queueing::Model model;
+     * fseamMock->dupeServer<FSeam::ClassName::functionName>(model, {FSeam::Latency::LogNormal{20ms, 0.5}, 200});
+     * FSeam::Queueing::Result result = model.run(1000, 10, [&](std::size_t) { testingClass.execute(); });
+     * result.percentile(0.99);
+     * @endcode
+     */
+    namespace Queueing {
+
+        struct Server {
+            Latency::Distribution serviceTime;
+            std::size_t concurrency = 1;
+        };
+
+        struct ServerReport {
+            double utilization(std::chrono::nanoseconds duration) const {
+                return duration.count() ? static_cast<double>(busy.count()) / static_cast<double>(duration.count() * concurrency) : 0.;
+            }
+            std::chrono::nanoseconds meanQueueingDelay() const {
+                return requests ? queueingDelay / static_cast<std::int64_t>(requests) : std::chrono::nanoseconds::zero();
+            }
+
+            std::string key;
+            std::size_t concurrency = 1;
+            std::size_t requests = 0;
+            std::size_t queued = 0;    // requests which waited for a free slot
+            std::chrono::nanoseconds busy = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds queueingDelay = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds maxQueueingDelay = std::chrono::nanoseconds::zero();
+        };
+
+        struct Result {
+            /**
+             * @return completed requests per second of virtual time
+             */
+            double throughput() const {
+                return duration.count() ? static_cast<double>(latencies.size()) * 1e9 / static_cast<double>(duration.count()) : 0.;
+            }
+
+            /**
+             * @param quantile between 0 and 1 (0.99 for the p99)
+             * @return latency of the requests at the given quantile (nearest rank)
+             */
+            std::chrono::nanoseconds percentile(double quantile) const {
+                if (latencies.empty())
+                    return std::chrono::nanoseconds::zero();
+                auto rank = static_cast<std::size_t>(std::ceil(quantile * static_cast<double>(latencies.size())));
+                return latencies[std::min(std::max<std::size_t>(rank, 1), latencies.size()) - 1];
+            }
+
+            std::size_t clients = 0;
+            std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();   // virtual time of the last completion
+            std::vector<std::chrono::nanoseconds> latencies;                        // of each request, sorted
+            std::map<std::string, ServerReport> servers;
+        };
+
+        namespace internal {
+
+            struct State {
+                struct Client {
+                    std::int64_t time = 0;
+                    bool done = false;
+                };
+                struct Station {
+                    ServerReport report;
+                    Latency::Distribution serviceTime;
+                    std::vector<std::int64_t> slots;   // time at which each slot is free
+                    std::size_t generation = 0;        // a method modeled again is served by its last server only
+                };
+
+                std::mutex mutex;
+                std::condition_variable scheduled;
+                std::vector<Client> clients;
+                std::size_t running = 0;
+                std::int64_t origin = 0;
+                std::mt19937_64 prng;
+                std::map<std::string, Station> stations;
+
+                std::int64_t sample(const Latency::Distribution &distribution) {
+                    return std::visit([this](const auto &d) { return d.sample(prng).count(); }, distribution);
+                }
+
+                // to call with the mutex locked, by the running client
+                void yield(std::unique_lock<std::mutex> &lock, std::size_t id) {
+                    if (Clock::isEnabled())
+                        clients[id].time = Clock::steadyNow().count() - origin;
+                    schedule();
+                    scheduled.wait(lock, [this, id] { return running == id; });
+                    if (Clock::isEnabled())
+                        Clock::internal::steady = origin + clients[id].time;
+                }
+
+                void schedule() {
+                    std::size_t next = clients.size();
+
+                    for (std::size_t i = 0; i < clients.size(); ++i) {
+                        if (!clients[i].done && (next == clients.size() || clients[i].time < clients[next].time))
+                            next = i;
+                    }
+                    running = next;
+                    scheduled.notify_all();
+                }
+
+                void serve(const std::string &key, std::size_t generation, std::size_t id) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    Station &station = stations.at(key);
+                    Client &client = clients[id];
+
+                    if (station.generation != generation)
+                        return;
+                    // the client time moved with the virtual clock (sleep), the clients behind it arrive first
+                    if (Clock::isEnabled())
+                        yield(lock, id);
+                    auto slot = std::min_element(station.slots.begin(), station.slots.end());
+                    std::int64_t start = std::max(client.time, *slot);
+                    std::int64_t service = std::max<std::int64_t>(sample(station.serviceTime), 0);
+                    ServerReport &report = station.report;
+
+                    ++report.requests;
+                    report.queued += start > client.time ? 1 : 0;
+                    report.busy += std::chrono::nanoseconds(service);
+                    report.queueingDelay += std::chrono::nanoseconds(start - client.time);
+                    report.maxQueueingDelay = std::max(report.maxQueueingDelay, std::chrono::nanoseconds(start - client.time));
+                    *slot = start + service;
+                    client.time = start + service;
+                    if (Clock::isEnabled())
+                        Clock::internal::steady = origin + client.time;
+                    yield(lock, id);
+                }
+            };
+
+            struct Running {
+                std::shared_ptr<State> state;
+                std::size_t client = 0;
+            };
+            inline thread_local Running running;
+        }
+
+        class Model {
+        public:
+            explicit Model(std::uint64_t seed = 5489u) : _seed(seed), _state(std::make_shared<internal::State>()) {}
+
+            /**
+             * @brief Model a mocked method as a server (see MockClassVerifier::dupeServer)
+             * @return handler to dupe the mocked method with
+             */
+            std::function<void(void *)> server(const std::string &key, Server server) {
+                internal::State::Station &station = _state->stations[key];
+
+                station.report.key = key;
+                station.report.concurrency = std::max<std::size_t>(server.concurrency, 1);
+                station.serviceTime = std::move(server.serviceTime);
+                return [key, generation = ++station.generation, state = std::weak_ptr<internal::State>(_state)](void *) {
+                    if (auto current = internal::running.state; current && current == state.lock())
+                        current->serve(key, generation, internal::running.client);
+                };
+            }
+
+            /**
+             * @brief Run the code under test with logical clients, in a closed loop: each client issues its requests one
+             *        after the other, optionally separated by a think time
+             *
+             * @param clients number of logical clients (one thread each)
+             * @param requestsPerClient number of requests issued by each client
+             * @param request code under test, called with the index of the client
+             * @param thinkTime delay between the completion of a request and the next one of the same client
+             * @return latency of each request, throughput and activity of each server
+             */
+            Result run(std::size_t clients, std::size_t requestsPerClient, const std::function<void(std::size_t)> &request,
+                       std::optional<Latency::Distribution> thinkTime = std::nullopt) {
+                internal::State &state = *_state;
+                std::vector<std::vector<std::chrono::nanoseconds> > latencies(clients);
+                std::exception_ptr error;
+                std::vector<std::thread> threads;
+
+                state.clients.assign(clients, {});
+                state.running = 0;
+                state.prng.seed(_seed);
+                state.origin = Clock::steadyNow().count();
+                for (auto &[key, station] : state.stations) {
+                    station.slots.assign(station.report.concurrency, 0);
+                    station.report = ServerReport{key, station.report.concurrency};
+                }
+                for (std::size_t id = 0; id < clients; ++id) {
+                    threads.emplace_back([&, id] {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        state.scheduled.wait(lock, [&state, id] { return state.running == id; });
+                        if (Clock::isEnabled())
+                            Clock::internal::steady = state.origin + state.clients[id].time;
+                        internal::running = {_state, id};
+                        try {
+                            for (std::size_t r = 0; r < requestsPerClient; ++r) {
+                                std::int64_t start = state.clients[id].time;
+
+                                lock.unlock();
+                                request(id);
+                                lock.lock();
+                                if (Clock::isEnabled())
+                                    state.clients[id].time = Clock::steadyNow().count() - state.origin;
+                                latencies[id].emplace_back(state.clients[id].time - start);
+                                if (thinkTime && r + 1 < requestsPerClient) {
+                                    state.clients[id].time += std::max<std::int64_t>(state.sample(*thinkTime), 0);
+                                    state.yield(lock, id);
+                                }
+                            }
+                        }
+                        catch (...) {
+                            if (!lock.owns_lock())
+                                lock.lock();
+                            if (!error)
+                                error = std::current_exception();
+                        }
+                        internal::running = {};
+                        state.clients[id].done = true;
+                        state.schedule();
+                    });
+                }
+                for (std::thread &thread : threads)
+                    thread.join();
+                if (error)
+                    std::rethrow_exception(error);
+
+                Result result {};
+                result.clients = clients;
+                for (std::size_t id = 0; id < clients; ++id) {
+                    result.duration = std::max(result.duration, std::chrono::nanoseconds(state.clients[id].time));
+                    result.latencies.insert(result.latencies.end(), latencies[id].begin(), latencies[id].end());
+                }
+                std::sort(result.latencies.begin(), result.latencies.end());
+                for (const auto &[key, station] : state.stations)
+                    result.servers[key] = station.report;
+                if (Clock::isEnabled())
+                    Clock::internal::steady = state.origin + result.duration.count();
+                return result;
+            }
+
+        private:
+            std::uint64_t _seed;
+            std::shared_ptr<internal::State> _state;
+        };
+
+    }
+
+    namespace report::internal {
+
+        /**
+         * @return timestamp of the entry / exit of a mocked call for the concurrency analysis: time of the client in a
+         *         queueing model run, the virtual clock if enabled, the steady clock otherwise
+         */
+        inline std::int64_t callTimestamp() {
+            if (const Queueing::internal::Running &running = Queueing::internal::running; running.state)
+                return running.state->origin + running.state->clients[running.client].time;
+            if (Clock::isEnabled())
+                return Clock::steadyNow().count();
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+
+        struct CallEntry {
+            std::string key;
+            std::int64_t time = 0;
+        };
+        // entries of the mocked calls in progress on the thread (a dupe handler can call another mock)
+        inline thread_local std::vector<CallEntry> callEntries;
+
+        /**
+         * @brief Remove the entry of a mocked call whose dupe handler throws (the call is then never registered)
+         */
+        class CallEntryGuard {
+        public:
+            CallEntryGuard(const std::string &key, bool entered) : _key(key), _dismissed(!entered) {}
+
+            ~CallEntryGuard() {
+                if (_dismissed)
+                    return;
+                auto it = std::find_if(callEntries.rbegin(), callEntries.rend(), [this](const auto &e) { return e.key == _key; });
+                if (it != callEntries.rend())
+                    callEntries.erase(std::prev(it.base()));
+            }
+
+            void dismiss() { _dismissed = true; }
+
+        private:
+            const std::string &_key;
+            bool _dismissed;
+        };
+    }
+
+    /**
+     * @brief Opt-in tracer of the mocked calls timeline, exported as a Chrome trace-event JSON file (chrome://tracing,
+     *        Perfetto UI)
+     * @details Each mocked call is an event with its thread, start time, duration (from the entry of the mocked method to
+     *          the call registration, including the original implementation for a spy) and duration of the dupe handler.
+     *          Events are appended into a per thread buffer without any lock, the buffers are registered once per thread.
+     *          The trace is not cleared by MockVerifier::cleanUp, it covers the whole test binary.
+     */
+    namespace Trace {
+
+        struct Event {
+            std::string className;
+            std::string methodName;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::nanoseconds handler = std::chrono::nanoseconds::zero();
+            std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+        };
+
+        namespace internal {
+            struct Buffer {
+                std::size_t tid = 0;
+                std::vector<Event> events;
+                std::vector<Event> pending; // started mocked calls (a dupe handler can call another mock)
+                std::chrono::steady_clock::time_point handlerStart;
+            };
+
+            inline std::atomic<bool> enabled {false};
+            inline std::mutex mutex; // protect the buffer registration only
+            inline std::vector<std::shared_ptr<Buffer> > buffers;
+            inline std::string path;
+            inline const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+            inline Buffer &buffer() {
+                thread_local std::shared_ptr<Buffer> local = [] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto created = std::make_shared<Buffer>();
+                    created->tid = buffers.size() + 1;
+                    buffers.emplace_back(created);
+                    return created;
+                }();
+                return *local;
+            }
+
+            inline std::string escape(const std::string &value) {
+                std::string escaped;
+
+                for (char c : value) {
+                    if (c == '"' || c == '\\')
+                        escaped += '\\';
+                    escaped += c;
+                }
+                return escaped;
+            }
+        }
+
+        inline bool isEnabled() {
+            return internal::enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @note This method should never be used by the client directly, entry of a mocked call
+         */
+        inline void begin(const std::string &className, const std::string &methodName) {
+            internal::Buffer &buffer = internal::buffer();
+            buffer.pending.emplace_back(Event{className, methodName, std::chrono::steady_clock::now()});
+            buffer.handlerStart = std::chrono::steady_clock::now();
+        }
+
+        /**
+         * @note This method should never be used by the client directly, the dupe handler of the mocked call returned
+         */
+        inline void handled() {
+            internal::Buffer &buffer = internal::buffer();
+            if (!buffer.pending.empty())
+                buffer.pending.back().handler = std::chrono::steady_clock::now() - buffer.handlerStart;
+        }
+
+        /**
+         * @note This method should never be used by the client directly, exit of a mocked call
+         */
+        inline void end() {
+            internal::Buffer &buffer = internal::buffer();
+            if (buffer.pending.empty())
+                return;
+            Event &event = buffer.pending.back();
+            event.duration = std::chrono::steady_clock::now() - event.start;
+            buffer.events.emplace_back(std::move(event));
+            buffer.pending.pop_back();
+        }
+
+        /**
+         * @return the events recorded on all the threads, with their thread id (1 for the first thread that called a mock)
+         * @note to be called when the threads calling mocks are done (joined)
+         */
+        inline std::vector<std::pair<std::size_t, Event> > events() {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            std::vector<std::pair<std::size_t, Event> > result;
+
+            for (const auto &buffer : internal::buffers) {
+                for (const auto &event : buffer->events)
+                    result.emplace_back(buffer->tid, event);
+            }
+            return result;
+        }
+
+        inline void clear() {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            for (const auto &buffer : internal::buffers)
+                buffer->events.clear();
+        }
+
+        /**
+         * @brief Write the recorded events in the Chrome trace-event JSON format (complete events, timestamps in
+         *        microseconds from the start of the test binary)
+         * @note to be called when the threads calling mocks are done (joined)
+         * @return true if the file has been written, false otherwise
+         */
+        inline bool write(const std::string &path) {
+            std::ofstream file(path, std::ios::trunc);
+            auto micro = [](std::chrono::nanoseconds duration) {
+                return std::to_string(duration.count() / 1000) + "." + std::to_string(1000 + duration.count() % 1000).substr(1);
+            };
+            bool first = true;
+
+            if (!file) {
+                Logging::Logger::log(Logging::Level::ERROR, "Trace file " + path + " can't be opened\n");
+                return false;
+            }
+            file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            for (const auto &[tid, event] : events()) {
+                file << (first ? "\n" : ",\n") << "{\"name\":\"" << internal::escape(event.methodName)
+                     << "\",\"cat\":\"" << internal::escape(event.className) << "\",\"ph\":\"X\",\"pid\":" << ::getpid()
+                     << ",\"tid\":" << tid << ",\"ts\":" << micro(event.start - internal::origin)
+                     << ",\"dur\":" << micro(event.duration) << ",\"args\":{\"handler_us\":" << micro(event.handler) << "}}";
+                first = false;
+            }
+            file << "\n]}\n";
+            return file.good();
+        }
+
+        /**
+         * @brief Enable the tracer
+         * @param path if not empty, the trace is written to this file at the exit of the test binary
+         */
+        inline void enable(const std::string &path = "", bool enable = true) {
+            static const bool writeAtExit = [] {
+                return std::atexit([] {
+                    if (!internal::path.empty())
+                        write(internal::path);
+                }) == 0;
+            }();
+
+            (void)writeAtExit;
+            internal::path = path;
+            internal::enabled = enable;
+        }
+
+    }
+
+    /**
+     * @brief RAII accounting scope, the mocked calls done while the scope is alive (on the same thread) are accounted into it
+     * @details Scopes can be nested, a mocked call is accounted in all the alive scopes of the thread.
+     *
+     * @example
+     * @code
+     * {
+     *      FSeam::Scope scope("checkout");
+     *      testingClass.execute();
+     *      REQUIRE(FSeam::verifyCostBudget(scope, 10.));
+     * }
+     * @endcode
+     */
+    class Scope {
+    public:
+        struct MethodCost {
+            std::size_t calls = 0;
+            double cost = 0.;
+        };
+
+        explicit Scope(std::string name = "") : _name(std::move(name)) {
+            _active.emplace_back(this);
+        }
+        ~Scope() {
+            _active.erase(std::remove(_active.begin(), _active.end(), this), _active.end());
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /**
+         * @note This method should never be used by the client directly, charge the cost of a mocked call into the alive scopes
+         */
+        static void charge(const std::string &key, double cost) {
+            for (Scope *scope : _active) {
+                MethodCost &methodCost = scope->_costs[key];
+                ++methodCost.calls;
+                methodCost.cost += cost;
+                scope->_cost += cost;
+            }
+        }
+
+        /**
+         * @note This method should never be used by the client directly, count the argument payload of a mocked call
+         *       into the alive scopes (see report::enablePayload)
+         */
+        static void payloadIn(const std::string &key, std::size_t bytes) {
+            for (Scope *scope : _active) {
+                report::Payload &payload = scope->_payloads[key];
+                payload.key = key;
+                payload.passed(bytes);
+                scope->_payload.passed(bytes);
+            }
+        }
+
+        /**
+         * @note This method should never be used by the client directly, count the return value payload of a mocked
+         *       call into the alive scopes (see report::enablePayload)
+         */
+        static void payloadOut(const std::string &key, std::size_t bytes) {
+            for (Scope *scope : _active) {
+                scope->_payloads[key].returned(bytes);
+                scope->_payload.returned(bytes);
+            }
+        }
+
+        static bool hasActive() { return !_active.empty(); }
+
+        const std::string &name() const { return _name; }
+        double cost() const { return _cost; }
+        const std::map<std::string, MethodCost> &costs() const { return _costs; }
+        const report::Payload &payload() const { return _payload; }
+        const std::map<std::string, report::Payload> &payloads() const { return _payloads; }
+
+    private:
+        std::string _name;
+        double _cost = 0.;
+        std::map<std::string, MethodCost> _costs;
+        report::Payload _payload;
+        std::map<std::string, report::Payload> _payloads;
+
+        inline static thread_local std::vector<Scope *> _active;
+    };
+
+    /**
+     * @brief Heap allocation counters of an AllocationScope (or of a thread)
+     */
+    struct AllocationCounters {
+        void allocated(std::size_t size, std::size_t usableSize) noexcept {
+            ++allocations;
+            bytes += size;
+            liveBytes += static_cast<std::int64_t>(usableSize);
+            peakLiveBytes = std::max(peakLiveBytes, liveBytes);
+        }
+        void deallocated(std::size_t usableSize) noexcept {
+            ++deallocations;
+            liveBytes -= static_cast<std::int64_t>(usableSize);
+        }
+
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytes = 0;
+        std::int64_t liveBytes = 0;
+        std::int64_t peakLiveBytes = 0;
+    };
+
+    /**
+     * @brief RAII allocation accounting scope, used with the allocation seam (seams/alloc.cc, linked with
+     *        addFSeamTests(... SEAMS alloc)): the heap allocations (operator new / malloc family) done by the thread
+     *        while the scope is alive are counted into it
+     * @details Scopes can be nested, an allocation is counted in all the alive scopes of the thread. The live bytes are
+     *          the bytes allocated minus the bytes deallocated while the scope is alive (memory allocated before the
+     *          scope and released into it makes it negative).
+     *
+     * @example
+     * @code
+     * {
+     *     FSeam::AllocationScope scope("hot path");
+     *     testingClass.execute();
+     *     REQUIRE(FSeam::verifyAllocations(scope, FSeam::AtMost(0)));
+     * }
+     * @endcode
+     */
+    class AllocationScope {
+    public:
+        using Counters = AllocationCounters;
+
+        explicit AllocationScope(std::string name = "") : _name(std::move(name)), _previous(_current) {
+            _current = this;
+        }
+        ~AllocationScope() {
+            _current = _previous;
+        }
+        AllocationScope(const AllocationScope &) = delete;
+        AllocationScope &operator=(const AllocationScope &) = delete;
+
+        /**
+         * @note This method should never be used by the client directly, it is called by the allocation seam
+         *       (it doesn't allocate)
+         */
+        static void allocated(std::size_t size, std::size_t usableSize) noexcept {
+            _thread.allocated(size, usableSize);
+            for (AllocationScope *scope = _current; scope; scope = scope->_previous)
+                scope->_counters.allocated(size, usableSize);
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is called by the allocation seam
+         *       (it doesn't allocate)
+         */
+        static void deallocated(std::size_t usableSize) noexcept {
+            _thread.deallocated(usableSize);
+            for (AllocationScope *scope = _current; scope; scope = scope->_previous)
+                scope->_counters.deallocated(usableSize);
+        }
+
+        /**
+         * @return the allocations of the current thread since its start
+         */
+        static const Counters &thread() { return _thread; }
+
+        const std::string &name() const { return _name; }
+        const Counters &counters() const { return _counters; }
+
+    private:
+        std::string _name;
+        AllocationScope *_previous;
+        Counters _counters {};
+
+        // trivial thread locals: no allocation on first access from the seam
+        inline static thread_local AllocationScope *_current = nullptr;
+        inline static thread_local Counters _thread {};
+    };
+
+    /**
+     * @brief Syscalls counted by the seams (syscall seam, and the file I/O, clock and socket seams when linked)
+     */
+    enum class Syscall : std::size_t { READ, WRITE, PREAD, PWRITE, FSYNC, FDATASYNC, MMAP, CLOCK_GETTIME, EPOLL_WAIT, COUNT };
+
+    inline const std::string &syscallName(Syscall syscall) {
+        static const std::array<std::string, static_cast<std::size_t>(Syscall::COUNT)> names {
+            "read", "write", "pread", "pwrite", "fsync", "fdatasync", "mmap", "clock_gettime", "epoll_wait"
+        };
+        return names[static_cast<std::size_t>(syscall)];
+    }
+
+    struct SyscallCount {
+        std::size_t calls = 0;
+        std::size_t bytes = 0;   // bytes transferred (read / write calls) or mapped (mmap)
+    };
+
+    struct SyscallCounters {
+        void counted(Syscall syscall, std::int64_t bytes) noexcept {
+            SyscallCount &count = counts[static_cast<std::size_t>(syscall)];
+            ++count.calls;
+            count.bytes += static_cast<std::size_t>(std::max<std::int64_t>(bytes, 0));
+        }
+        const SyscallCount &operator[](Syscall syscall) const { return counts[static_cast<std::size_t>(syscall)]; }
+
+        std::array<SyscallCount, static_cast<std::size_t>(Syscall::COUNT)> counts {};
+    };
+
+    /**
+     * @brief RAII syscall accounting scope, used with the syscall seam (seams/syscall.cc, linked with
+     *        addFSeamTests(... SEAMS syscall)): the syscalls done by the thread while the scope is alive are counted into it
+     * @details Scopes can be nested, a syscall is counted in all the alive scopes of the thread. The syscall seam only
+     *          counts and forwards to the kernel, it is combined with the file I/O, clock and socket seams (which are
+     *          counting as well, the in-memory calls included).
+     *
+     * @example
+     * @code
+     * {
+     *     FSeam::SyscallScope scope("flush");
+     *     journal.flush();
+     *     REQUIRE(FSeam::verifySyscalls(scope, {{"fsync", FSeam::AtMost(1)}, {"write", FSeam::AtMost(4)}}));
+     * }
+     * @endcode
+     */
+    class SyscallScope {
+    public:
+        using Counters = SyscallCounters;
+
+        explicit SyscallScope(std::string name = "") : _name(std::move(name)), _previous(_current) {
+            _current = this;
+        }
+        ~SyscallScope() {
+            _current = _previous;
+        }
+        SyscallScope(const SyscallScope &) = delete;
+        SyscallScope &operator=(const SyscallScope &) = delete;
+
+        /**
+         * @note This method should never be used by the client directly, it is called by the seams (it doesn't allocate)
+         * @param bytes result of the call for the read / write calls (negative results aren't counted as bytes)
+         */
+        static void count(Syscall syscall, std::int64_t bytes = 0) noexcept {
+            _thread.counted(syscall, bytes);
+            for (SyscallScope *scope = _current; scope; scope = scope->_previous)
+                scope->_counters.counted(syscall, bytes);
+        }
+
+        /**
+         * @return the syscalls of the current thread since its start
+         */
+        static const Counters &thread() { return _thread; }
+
+        const std::string &name() const { return _name; }
+        const Counters &counters() const { return _counters; }
+
+    private:
+        std::string _name;
+        SyscallScope *_previous;
+        Counters _counters {};
+
+        inline static thread_local SyscallScope *_current = nullptr;
+        inline static thread_local Counters _thread {};
+    };
+
+    struct LockStats {
+        std::size_t acquisitions = 0;
+        std::size_t contended = 0;             // acquisitions which had to wait (the lock was taken by another thread)
+        std::size_t waits = 0;                 // condition variable waits
+        std::size_t signals = 0;               // condition variable signals and broadcasts
+        std::chrono::nanoseconds held {0};     // total hold time of the lock
+        std::chrono::nanoseconds maxHeld {0};
+    };
+
+    /**
+     * @brief Lock counters of a scope: totals and stats per address of mutex / condition variable
+     * @note The stats are kept in place (no allocation from the lock seam), the locks after the first MAX_LOCKS are only
+     *       counted in the totals
+     */
+    struct LockCounters {
+        static constexpr std::size_t MAX_LOCKS = 64;
+
+        LockStats &of(const void *address) noexcept {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (locks[i].first == address)
+                    return locks[i].second;
+            }
+            if (size == MAX_LOCKS)
+                return overflow;
+            locks[size].first = address;
+            return locks[size++].second;
+        }
+
+        /**
+         * @return stats of the mutex / condition variable at the given address (empty stats if not used into the scope)
+         */
+        LockStats of(const void *address) const {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (locks[i].first == address)
+                    return locks[i].second;
+            }
+            return LockStats {};
+        }
+
+        LockStats total {};
+        std::array<std::pair<const void *, LockStats>, MAX_LOCKS> locks {};
+        std::size_t size = 0;
+        LockStats overflow {};
+    };
+
+    /**
+     * @brief RAII lock accounting scope, used with the lock seam (seams/lock.cc, linked with addFSeamTests(... SEAMS lock)):
+     *        the pthread mutex acquisitions and condition variable calls done by the thread while the scope is alive are
+     *        counted into it, per address of mutex / condition variable
+     * @details Scopes can be nested, a lock is counted in all the alive scopes of the thread. The locks are only counted
+     *          while a scope is alive (the seam is a plain forward otherwise). The hold time of a lock is counted when it is
+     *          acquired and released into the scope.
+     *
+     * @example
+     * @code
+     * {
+     *     FSeam::LockScope scope("request path");
+     *     server.handle(request);
+     *     REQUIRE(FSeam::verifyLocks(scope, FSeam::AtMost(2)));
+     * }
+     * @endcode
+     */
+    class LockScope {
+    public:
+        using Counters = LockCounters;
+
+        explicit LockScope(std::string name = "") : _name(std::move(name)), _previous(_current) {
+            _current = this;
+        }
+        ~LockScope() {
+            _current = _previous;
+        }
+        LockScope(const LockScope &) = delete;
+        LockScope &operator=(const LockScope &) = delete;
+
+        static bool isActive() noexcept { return _current != nullptr; }
+
+        /**
+         * @note Those methods should never be used by the client directly, they are called by the lock seam (they don't
+         *       allocate nor lock)
+         */
+        static void acquired(const void *mutex, bool contended, std::chrono::nanoseconds now) noexcept {
+            if (_heldCount < _held.size())
+                _held[_heldCount++] = {mutex, now};
+            forEach(mutex, [contended](LockStats &stats) {
+                ++stats.acquisitions;
+                stats.contended += contended ? 1 : 0;
+            });
+        }
+        static void released(const void *mutex, std::chrono::nanoseconds now) noexcept {
+            for (std::size_t i = _heldCount; i > 0; --i) {
+                if (_held[i - 1].first != mutex)
+                    continue;
+                std::chrono::nanoseconds held = now - _held[i - 1].second;
+                _held[i - 1] = _held[--_heldCount];
+                forEach(mutex, [held](LockStats &stats) {
+                    stats.held += held;
+                    stats.maxHeld = std::max(stats.maxHeld, held);
+                });
+                return;
+            }
+        }
+        static void waited(const void *condition) noexcept {
+            forEach(condition, [](LockStats &stats) { ++stats.waits; });
+        }
+        static void signaled(const void *condition) noexcept {
+            forEach(condition, [](LockStats &stats) { ++stats.signals; });
+        }
+
+        const std::string &name() const { return _name; }
+        const Counters &counters() const { return _counters; }
+
+    private:
+        template <typename Update>
+        static void forEach(const void *address, Update &&update) noexcept {
+            for (LockScope *scope = _current; scope; scope = scope->_previous) {
+                update(scope->_counters.total);
+                update(scope->_counters.of(address));
+            }
+        }
+
+    private:
+        std::string _name;
+        LockScope *_previous;
+        Counters _counters {};
+
+        inline static thread_local LockScope *_current = nullptr;
+        // locks acquired into a scope and not released yet, with their acquisition time
+        inline static thread_local std::array<std::pair<const void *, std::chrono::nanoseconds>, 32> _held {};
+        inline static thread_local std::size_t _heldCount = 0;
+    };
+
+    /**
+     * @brief Record the calls of spied methods (arguments and return value) into an append-only binary file, and replay
+     *        them through the mocks of the same methods (see MockClassVerifier::record / MockClassVerifier::replay)
+     * @details A record file starts with the FSEAMREC magic and a version, followed by the records:
+     *          [u32 key size][u32 args size][u32 return size][key][args][return], where the key is the class name followed
+     *          by the method name, args is the encoded argument tuple ([u32 size][bytes] per argument)
+     */
+    namespace Record {
+
+        inline constexpr std::string_view MAGIC = "FSEAMREC";
+        inline constexpr std::uint32_t VERSION = 1;
+
+        /**
+         * @brief Binary encoding of a type into a record file, provided for the trivially copyable types (pointers
+         *        excepted) and std::string. A specialization can be provided for the other types.
+         */
+        template <typename T, typename = void>
+        struct Codec {
+            static constexpr bool serializable = false;
+            static void encode(std::string &, const T &) {}
+            static bool decode(std::string_view, T &) { return false; }
+        };
+        template <typename T>
+        struct Codec<T, std::enable_if_t<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> > > {
+            static constexpr bool serializable = true;
+            static void encode(std::string &out, const T &value) {
+                out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+            }
+            static bool decode(std::string_view in, T &value) {
+                if (in.size() != sizeof(T))
+                    return false;
+                std::memcpy(&value, in.data(), sizeof(T));
+                return true;
+            }
+        };
+        template <>
+        struct Codec<std::string> {
+            static constexpr bool serializable = true;
+            static void encode(std::string &out, const std::string &value) { out.append(value); }
+            static bool decode(std::string_view in, std::string &value) {
+                value.assign(in.data(), in.size());
+                return true;
+            }
+        };
+
+        namespace internal {
+            inline void appendSize(std::string &out, std::size_t size) {
+                std::uint32_t size32 = static_cast<std::uint32_t>(size);
+                out.append(reinterpret_cast<const char *>(&size32), sizeof(size32));
+            }
+
+            inline std::uint32_t readSize(const char *in) {
+                std::uint32_t size;
+                std::memcpy(&size, in, sizeof(size));
+                return size;
+            }
+
+            /**
+             * @return the encoded argument tuple, std::nullopt if one of them isn't serializable
+             */
+            template <typename ...Args>
+            std::optional<std::string> encodeArgs(const Args &...args) {
+                if constexpr ((Codec<std::decay_t<Args> >::serializable && ...)) {
+                    std::string out;
+                    auto encode = [&out](const auto &arg) {
+                        std::string encoded;
+                        Codec<std::decay_t<decltype(arg)> >::encode(encoded, arg);
+                        appendSize(out, encoded.size());
+                        out.append(encoded);
+                    };
+                    (encode(args), ...);
+                    return out;
+                }
+                else
+                    return std::nullopt;
+            }
+        }
+
+        enum class Mode {
+            IN_ORDER,  // the records of a method are served in the recorded order
+            BY_ARGS    // the records of a method with the same arguments are served in the recorded order
+        };
+
+        /**
+         * @brief Append-only writer of a record file
+         */
+        class Recorder {
+        public:
+            explicit Recorder(const std::string &path) : _file(path, std::ios::binary | std::ios::app) {
+                if (!_file) {
+                    Logging::Logger::log(Logging::Level::ERROR, "Record file " + path + " can't be opened\n");
+                    return;
+                }
+                if (_file.tellp() == 0) {
+                    _file.write(MAGIC.data(), MAGIC.size());
+                    _file.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+                }
+            }
+
+            bool good() const { return _file.good(); }
+            std::size_t recorded() const { return _recorded; }
+
+            void append(const std::string &key, const std::string &args, const std::string &ret) {
+                std::string header;
+
+                internal::appendSize(header, key.size());
+                internal::appendSize(header, args.size());
+                internal::appendSize(header, ret.size());
+                _file.write(header.data(), header.size());
+                _file.write(key.data(), key.size());
+                _file.write(args.data(), args.size());
+                _file.write(ret.data(), ret.size());
+                ++_recorded;
+            }
+
+            void flush() { _file.flush(); }
+
+        private:
+            std::ofstream _file;
+            std::size_t _recorded = 0;
+        };
+
+        /**
+         * @brief Reader of a record file: the file is memory mapped and indexed per key, the records are decoded only
+         *        when served
+         */
+        class Replayer {
+            struct Entry {
+                std::string_view args;
+                std::string_view ret;
+            };
+            struct Method {
+                std::vector<Entry> entries;
+                std::size_t next = 0;
+                std::unordered_map<std::string_view, std::vector<std::size_t> > byArgs;
+                std::unordered_map<std::string_view, std::size_t> nextByArgs;
+            };
+
+        public:
+            explicit Replayer(const std::string &path) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                struct stat st {};
+
+                if (fd < 0 || ::fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(MAGIC.size() + sizeof(VERSION))) {
+                    Logging::Logger::log(Logging::Level::ERROR, "Record file " + path + " can't be replayed\n");
+                    if (fd >= 0)
+                        ::close(fd);
+                    return;
+                }
+                void *mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (mapped == MAP_FAILED) {
+                    Logging::Logger::log(Logging::Level::ERROR, "Record file " + path + " can't be mapped\n");
+                    return;
+                }
+                _mapped = static_cast<const char *>(mapped);
+                _size = static_cast<std::size_t>(st.st_size);
+                index(path);
+            }
+            ~Replayer() {
+                if (_mapped)
+                    ::munmap(const_cast<char *>(_mapped), _size);
+            }
+            Replayer(const Replayer &) = delete;
+            Replayer &operator=(const Replayer &) = delete;
+
+            bool good() const { return _mapped != nullptr; }
+            std::size_t records() const { return _records; }
+            std::size_t served() const { return _served; }
+            std::size_t missed() const { return _missed; }
+
+            /**
+             * @brief Get the next recorded return value of a method
+             * @param key class name followed by the method name
+             * @param args encoded arguments of the call (ignored in Mode::IN_ORDER)
+             * @return the encoded return value, std::nullopt if no record is left for the call
+             */
+            std::optional<std::string_view> next(const std::string &key, const std::optional<std::string> &args, Mode mode) {
+                auto it = _methods.find(key);
+
+                if (it != _methods.end()) {
+                    Method &method = it->second;
+                    if (mode == Mode::IN_ORDER && method.next < method.entries.size()) {
+                        ++_served;
+                        return method.entries[method.next++].ret;
+                    }
+                    if (mode == Mode::BY_ARGS && args) {
+                        if (auto match = method.byArgs.find(*args); match != method.byArgs.end()) {
+                            std::size_t &next = method.nextByArgs[match->first];
+                            if (next < match->second.size()) {
+                                ++_served;
+                                return method.entries[match->second[next++]].ret;
+                            }
+                        }
+                    }
+                }
+                ++_missed;
+                return std::nullopt;
+            }
+
+        private:
+            void index(const std::string &path) {
+                std::size_t offset = MAGIC.size() + sizeof(VERSION);
+                std::uint32_t version = internal::readSize(_mapped + MAGIC.size());
+
+                if (std::string_view(_mapped, MAGIC.size()) != MAGIC || version != VERSION) {
+                    Logging::Logger::log(Logging::Level::ERROR, "Record file " + path + " has an unknown format\n");
+                    return;
+                }
+                while (offset + 3 * sizeof(std::uint32_t) <= _size) {
+                    std::size_t keySize = internal::readSize(_mapped + offset);
+                    std::size_t argsSize = internal::readSize(_mapped + offset + sizeof(std::uint32_t));
+                    std::size_t retSize = internal::readSize(_mapped + offset + 2 * sizeof(std::uint32_t));
+                    offset += 3 * sizeof(std::uint32_t);
+                    if (offset + keySize + argsSize + retSize > _size) {
+                        Logging::Logger::log(Logging::Level::WARNING, "Record file " + path + " is truncated\n");
+                        break;
+                    }
+                    Method &method = _methods[std::string(_mapped + offset, keySize)];
+                    Entry entry {{_mapped + offset + keySize, argsSize}, {_mapped + offset + keySize + argsSize, retSize}};
+                    method.byArgs[entry.args].emplace_back(method.entries.size());
+                    method.entries.emplace_back(entry);
+                    offset += keySize + argsSize + retSize;
+                    ++_records;
+                }
+            }
+
+            const char *_mapped = nullptr;
+            std::size_t _size = 0;
+            std::size_t _records = 0;
+            std::size_t _served = 0;
+            std::size_t _missed = 0;
+            std::unordered_map<std::string, Method> _methods;
+        };
+
+    }
+
+    /**
+     * @brief Per process metrics of the mocked calls, accumulated over the test cases (at each MockVerifier::cleanUp)
+     *        and written at the exit of the test binary (see Metrics::enable)
+     */
+    namespace Metrics {
+
+        enum class Format {
+            JSON,
+            OPEN_METRICS
+        };
+
+        struct MethodMetrics {
+            std::string className;
+            std::string methodName;
+            std::size_t calls = 0;
+            std::size_t expectationHits = 0;
+            std::size_t capturedBytes = 0;
+        };
+
+        namespace internal {
+            inline std::atomic<bool> enabled {false};
+            inline std::mutex mutex;
+            inline std::map<std::pair<std::string, std::string>, MethodMetrics> totals;
+            inline std::string directory;
+            inline Format format = Format::JSON;
+
+            inline void accumulate(const MethodMetrics &metrics) {
+                std::lock_guard<std::mutex> lock(mutex);
+                MethodMetrics &total = totals[{metrics.className, metrics.methodName}];
+
+                total.className = metrics.className;
+                total.methodName = metrics.methodName;
+                total.calls += metrics.calls;
+                total.expectationHits += metrics.expectationHits;
+                total.capturedBytes += metrics.capturedBytes;
+            }
+        }
+
+        inline bool isEnabled() {
+            return internal::enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Clear the metrics accumulated by the previous cleanUp
+         */
+        inline void reset() {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            internal::totals.clear();
+        }
+
+    }
+
+    /**
+     * @brief basic structure that contains description and usage metadata of a mocked method
+     */
+    template<class... Ts> struct overload : Ts... { using Ts::operator()...; };
+    template<class... Ts> overload(Ts...) -> overload<Ts...>;
+
+    struct MethodCallVerifier {
+        using CalledCompare = std::variant<IsNot, AtMost, AtLeast, NeverCalled, VerifyCompare>;
+
+        struct Expectation  {
+            bool operator()() {
+                return std::visit(overload {
+                    [this](auto& c) { return c.compare(_numberTimeMatched); }
+                }, _comparator);
+            }
+            void check(void *data) {
+                if (_expectator(data))
+                    ++_numberTimeMatched;
+            }
+            std::function<bool(void*)> _expectator;
+
+            CalledCompare _comparator;
+            uint _numberTimeMatched = 0;
+        };
+
+        struct ArgsTuple {
+            std::size_t count = 0;
+            std::string description;
+        };
+
+        /**
+         * @brief Record the arguments of a call for the redundant call analysis
+         */
+        template <typename ...Args>
+        void observeArgs(const Args &...args) {
+            std::optional<std::size_t> hash = report::internal::hashArgs(args...);
+
+            if (!hash) {
+                ++_unhashedCalls;
+                return;
+            }
+            ArgsTuple &tuple = _argsTuples[*hash];
+            if (!tuple.count)
+                tuple.description = report::internal::describeArgs(args...);
+            ++tuple.count;
+        }
+
+        /**
+         * @brief Add the arguments of a call to the sketches of the method (argument sketch analysis)
+         */
+        template <typename ...Args>
+        void sketchArgs(const Args &...args) {
+            if (_sketches.parameters.size() < sizeof...(Args))
+                _sketches.parameters.resize(sizeof...(Args));
+            ++_sketches.calls;
+            if (std::optional<std::size_t> hash = report::internal::hashArgs(args...); hash)
+                _sketches.distinctTuples.add(*hash);
+            std::size_t index = 0;
+            (_sketches.parameters[index++].observe(args), ...);
+        }
+
+        /**
+         * @brief Record the argument tuple of a call as a cache key (cache simulation analysis)
+         */
+        template <typename ...Args>
+        void recordCacheKey(const Args &...args) {
+            if (std::optional<std::size_t> hash = report::internal::hashArgs(args...); hash)
+                _cacheKeys.push_back(*hash);
+            else
+                ++_uncacheableCalls;
+        }
+
+        /**
+         * @return concurrency report of the method: sweep over the entry (+1) and exit (-1) of the calls, an exit being
+         *         handled before an entry of the same timestamp
+         */
+        report::Concurrency concurrency(std::string key) const {
+            report::Concurrency result {std::move(key), _inFlight.size()};
+            std::vector<std::pair<std::int64_t, int> > events;
+
+            for (const auto &[entry, exit] : _inFlight) {
+                events.emplace_back(entry, 1);
+                events.emplace_back(exit, -1);
+            }
+            std::sort(events.begin(), events.end());
+            std::size_t inFlight = 0;
+            std::int64_t previous = events.empty() ? 0 : events.front().first;
+            for (const auto &[time, delta] : events) {
+                if (inFlight >= 2)
+                    result.concurrentTime += std::chrono::nanoseconds(time - previous);
+                previous = time;
+                if (delta < 0) {
+                    --inFlight;
+                    continue;
+                }
+                result.overlappedCalls += inFlight ? 1 : 0;
+                result.maxInFlight = std::max(result.maxInFlight, ++inFlight);
+            }
+            return result;
+        }
+
+        /**
+         * @return redundant call report of the method, with the topN most repeated argument tuples
+         */
+        report::RedundantCall redundantCalls(std::string key, std::size_t topN = 5) const {
+            report::RedundantCall result {};
+
+            result.key = std::move(key);
+
+            result.distinct = _argsTuples.size();
+            result.unhashedCalls = _unhashedCalls;
+            for (const auto &[hash, tuple] : _argsTuples) {
+                result.calls += tuple.count;
+                if (tuple.count > 1)
+                    result.topTuples.emplace_back(tuple.description, tuple.count);
+            }
+            std::sort(result.topTuples.begin(), result.topTuples.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.second > rhs.second;
+            });
+            if (result.topTuples.size() > topN)
+                result.topTuples.resize(topN);
+            return result;
+        }
+
+        /**
+         * @brief Track the runs of consecutive calls for the chatty call analysis
+         * @param called method verifier of the mocked method being called
+         * @param hash hash of the arguments of the call, arguments that can't be hashed are considered as varying
+         */
+        static void sequenceCall(const std::shared_ptr<MethodCallVerifier> &called, std::optional<std::size_t> hash) {
+            std::lock_guard<std::mutex> lock(_sequenceMutex);
+            std::shared_ptr<MethodCallVerifier> last = _lastCalled.lock();
+
+            if (last != called) {
+                if (last)
+                    last->closeRun();
+                _lastCalled = called;
+            }
+            if (!called->_currentRun)
+                called->_runHash = hash;
+            else if (!hash || hash != called->_runHash)
+                called->_runVaried = true;
+            ++called->_currentRun;
+        }
+
+        void closeRun() {
+            if (_currentRun)
+                ++runLengthsOf(_currentRun, _runVaried, _runLengths, _identicalRuns)[_currentRun];
+            _currentRun = 0;
+            _runVaried = false;
+        }
+
+        static std::map<std::size_t, std::size_t> &runLengthsOf(std::size_t run, bool varied,
+                std::map<std::size_t, std::size_t> &chatty, std::map<std::size_t, std::size_t> &identical) {
+            return (run > 1 && !varied) ? identical : chatty;
+        }
+
+        /**
+         * @return chatty call report of the method, the current run (if any) is taken into account
+         */
+        report::ChattyCall chattyCalls(std::string key) const {
+            std::lock_guard<std::mutex> lock(_sequenceMutex);
+            report::ChattyCall result {};
+
+            result.key = std::move(key);
+            result.runLengths = _runLengths;
+            result.identicalRuns = _identicalRuns;
+            if (_currentRun)
+                ++runLengthsOf(_currentRun, _runVaried, result.runLengths, result.identicalRuns)[_currentRun];
+            for (const auto &[length, count] : result.runLengths) {
+                result.calls += length * count;
+                result.runs += count;
+                result.maxRun = std::max(result.maxRun, length);
+            }
+            for (const auto &[length, count] : result.identicalRuns)
+                result.calls += length * count;
+            return result;
+        }
+
+        std::string _methodName;
+        std::size_t _called = 0;
+        std::function<void(void*)> _handler;  
+        std::vector<Expectation> _expectations;      
+        std::unordered_map<std::size_t, ArgsTuple> _argsTuples;
+        std::size_t _unhashedCalls = 0;
+        std::map<std::size_t, std::size_t> _runLengths;
+        std::map<std::size_t, std::size_t> _identicalRuns;
+        std::size_t _currentRun = 0;
+        std::optional<std::size_t> _runHash;
+        bool _runVaried = false;
+        std::size_t _capturedBytes = 0;
+        std::function<double(void*)> _cost;
+        report::SpyCall _spy;
+        std::unordered_map<const void *, std::size_t> _callSites;
+        report::ArgumentSketches _sketches;
+        std::vector<std::uint64_t> _cacheKeys;
+        std::size_t _uncacheableCalls = 0;
+        report::Payload _payload;
+        std::vector<std::pair<std::int64_t, std::int64_t> > _inFlight;   // entry, exit of each call
+
+        // the runs span the mocks: the last called method and the runs are shared between the mocks of all the threads
+        inline static std::mutex _sequenceMutex;
+        inline static std::weak_ptr<MethodCallVerifier> _lastCalled;
+    };
+
+    /**
+     * @brief Mocking class, it contains all mocked method / save all calls to methods
+     * @details A mock verifier instance class is a class that acknowledge all utilisation (method calls) of the mocked class
+     *          this class also contains the mocked method (dupped).
+     * @todo improve the mocking class to take the arguments and compare them in a verify
+     */
+    class MockClassVerifier {
+    public:
+        explicit MockClassVerifier(std::string className) : _className(std::move(className)) {}
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         */
+        void invokeDupedMethod(const std::string &methodName, void *arg = nullptr) {
+            std::string key = _className + methodName;
+            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
+
+            if (report::Settings::transitions)
+                report::internal::TransitionTracker::entry(key);
+            if (Trace::isEnabled())
+                Trace::begin(_className, methodName);
+            bool entered = report::Settings::concurrency;
+            if (entered)
+                report::internal::callEntries.push_back({key, report::internal::callTimestamp()});
+            {
+                std::lock_guard<std::recursive_mutex> lock(_callMutex);
+                if (auto it = _verifiers.find(key); it != _verifiers.end())
+                    methodCallVerifier = it->second;
+            }
+            // the handler is called unlocked, the calls of several threads can be in flight at the same time
+            if (methodCallVerifier && methodCallVerifier->_handler) {
+                report::internal::CallEntryGuard guard {key, entered};
+                methodCallVerifier->_handler(arg);
+                guard.dismiss();
+            }
+            if (Trace::isEnabled())
+                Trace::handled();
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only (spy mode)
+         * @param elapsed time spent into the original implementation of the spied method
+         */
+        void spyCall(const std::string &methodName, std::chrono::nanoseconds elapsed) {
+            std::string key = _className + methodName;
+            std::lock_guard<std::recursive_mutex> lock(_callMutex);
+            std::shared_ptr<MethodCallVerifier> &methodCallVerifier = _verifiers[key];
+
+            if (!methodCallVerifier)
+                methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            report::SpyCall &spy = methodCallVerifier->_spy;
+            ++spy.calls;
+            spy.total += elapsed;
+            spy.max = std::max(spy.max, elapsed);
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @param returnAddress return address of the mocked method (call site into the code under test)
+         */
+        void callSite(const std::string &methodName, const void *returnAddress) {
+            std::string key = _className + methodName;
+            std::lock_guard<std::recursive_mutex> lock(_callMutex);
+            std::shared_ptr<MethodCallVerifier> &methodCallVerifier = _verifiers[key];
+
+            if (!methodCallVerifier)
+                methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            ++methodCallVerifier->_callSites[returnAddress];
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only (spy mode)
+         * @brief Record the call into the recorder set for the method (if any)
+         */
+        template <typename ReturnType, typename ...Args>
+        void recordCall(const std::string &methodName, const ReturnType &ret, const Args &...args) {
+            if (_recorders.empty())
+                return;
+            std::string key = _className + methodName;
+            auto it = _recorders.find(key);
+
+            if (it == _recorders.end())
+                return;
+            if constexpr (Record::Codec<std::decay_t<ReturnType> >::serializable) {
+                std::string encodedRet;
+                Record::Codec<std::decay_t<ReturnType> >::encode(encodedRet, ret);
+                it->second->append(key, Record::internal::encodeArgs(args...).value_or(""), encodedRet);
+            }
+            else
+                Logging::Logger::log(Logging::Level::WARNING, "Return value of " + key + " can't be recorded (no FSeam::Record::Codec)\n");
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @brief Set the return value of the call from the replayer set for the method (if any and if a record is left)
+         */
+        template <typename ReturnType, typename ...Args>
+        void replayCall(const std::string &methodName, ReturnType &ret, const Args &...args) {
+            if (_replayers.empty())
+                return;
+            std::string key = _className + methodName;
+            auto it = _replayers.find(key);
+
+            if (it == _replayers.end())
+                return;
+            if constexpr (Record::Codec<std::decay_t<ReturnType> >::serializable) {
+                auto &[replayer, mode] = it->second;
+                std::optional<std::string> encodedArgs;
+                if (mode == Record::Mode::BY_ARGS)
+                    encodedArgs = Record::internal::encodeArgs(args...);
+                if (auto encodedRet = replayer->next(key, encodedArgs, mode); encodedRet)
+                    Record::Codec<std::decay_t<ReturnType> >::decode(*encodedRet, ret);
+            }
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @param args arguments of the mocked call, used by the opt-in call analysis (see FSeam::report)
+         */
+        template <typename ...Args>
+        void methodCall(std::string methodName, void *data, const Args &...args) {
+            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
+            std::string key = _className + methodName;
+            std::optional<std::pair<std::int64_t, std::int64_t> > inFlight;
+
+            if (report::Settings::concurrency) {
+                auto &entries = report::internal::callEntries;
+                auto it = std::find_if(entries.rbegin(), entries.rend(), [&key](const auto &e) { return e.key == key; });
+                if (it != entries.rend()) {
+                    inFlight.emplace(it->time, report::internal::callTimestamp());
+                    entries.erase(std::prev(it.base()), entries.end());
+                }
+            }
+            std::lock_guard<std::recursive_mutex> lock(_callMutex);
+
+            if (_verifiers.find(key) != _verifiers.end())
+                methodCallVerifier = _verifiers.at(key);
+            else 
+                methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            for (auto &expectation : methodCallVerifier->_expectations)
+                expectation.check(data);
+            if (report::Settings::redundantCalls)
+                methodCallVerifier->observeArgs(args...);
+            if (report::Settings::sketches)
+                methodCallVerifier->sketchArgs(args...);
+            if (report::Settings::cacheSimulation)
+                methodCallVerifier->recordCacheKey(args...);
+            if (report::Settings::chattyCalls)
+                MethodCallVerifier::sequenceCall(methodCallVerifier, report::internal::hashArgs(args...));
+            if (methodCallVerifier->_cost && Scope::hasActive())
+                Scope::charge(key, methodCallVerifier->_cost(data));
+            if (Metrics::isEnabled())
+                methodCallVerifier->_capturedBytes += report::internal::payloadBytes(args...);
+            if (report::Settings::payload) {
+                std::size_t bytes = report::internal::payloadBytes(args...);
+                methodCallVerifier->_payload.passed(bytes);
+                Scope::payloadIn(key, bytes);
+            }
+            if (inFlight)
+                methodCallVerifier->_inFlight.emplace_back(*inFlight);
+            methodCallVerifier->_methodName = std::move(methodName);
+            methodCallVerifier->_called += 1;
+            if (report::Settings::transitions)
+                report::internal::TransitionTracker::exit(key);
+            if (Trace::isEnabled())
+                Trace::end();
+            _verifiers[std::move(key)] = methodCallVerifier;
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         * @param ret value returned by the mocked call, counted by the payload analysis (see report::enablePayload)
+         */
+        template <typename ReturnType>
+        void returnedPayload(const std::string &methodName, const ReturnType &ret) {
+            std::string key = _className + methodName;
+            std::size_t bytes = PayloadSize<std::decay_t<ReturnType> >::size(ret);
+            std::lock_guard<std::recursive_mutex> lock(_callMutex);
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end())
+                it->second->_payload.returned(bytes);
+            Scope::payloadOut(key, bytes);
+        }
+
+        /**
+         * Clear the expectations of the given method, if none provided, all expectation are removed
+         * @param methodName
+         */
+        void clearExpectations(std::optional<std::string> methodName = std::nullopt) {
+            if (methodName) {
+                std::string key = _className + std::move(*methodName);
+
+                if (_verifiers.find(key) != _verifiers.end()) {
+                    std::shared_ptr<MethodCallVerifier> &methodCallVerifier = _verifiers.at(key);
+                    methodCallVerifier->_expectations.clear();
+                }
+            }
+            else {
+                for( auto const& [key, val] : _verifiers)
+                    val->_expectations.clear();
+            }
+        }
+
+        /**
+         * @note This method should never be used by the client directly, it is a "FSeam generated" method only
+         */
+        void registerExpectation(std::string methodName, MethodCallVerifier::Expectation expectation) {
+            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
+            std::string key = _className + std::move(methodName);
+
+            if (_verifiers.find(key) != _verifiers.end())
+                methodCallVerifier = _verifiers.at(key);
+            else 
+                methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            methodCallVerifier->_expectations.emplace_back(std::move(expectation));
+            _verifiers[std::move(key)] = methodCallVerifier;
+        }
+
+        /**
+         * @details Add an expectation on the specified method (template specification on a FSeam generated structure representing
+         *        a specific method for a mocked class).
+         *        It is important to note that a call to verify has to be done in order to check those expectations.
+         * @note Working in a similar way to dupeMethod, it is required that the expectation are set before launching your executions
+         *       as the library is going to check registered expectations at runtime. The verify check at the end is used in order
+         *       to check if the number of occurence.
+         *
+         * @example
+         * @code
+         * class ClassName {
+         * public:
+         *      void functionName(int arg1, int arg2, int arg3);
+         * };
+         *
+         * void test () {
+         *      ClassName instance {};
+         *      auto fseamMock = FSeam::get(&instance);
+         *      // !! No execution here, otherwise it won't be checked by the following expectArg
+         *      fseamMock->expectArg<FSeam::ClassName::functionName>(FSeam::Eq{24}, FSeam::NotEq{55}, FSeam::Any{});
+         *      //.... code that execute functionName at some point
+         *      // verify the method has been called at least once with first arg equal 21, second not equal 55, and third anything
+         *      assert(fseamMock->verify(FSeam::ClassName::functionName::NAME));
+         * }
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @tparam Verifiers could be simple type (in this case the comparator FSeam::Eq is being called) or any Comparator,
+         * @param verifiers comparator used in order to check the arguments of the method identified by ClassMethodIdentifier
+         * @return true if the method has been called at least once, false otherwise
+         */
+        template <typename ClassMethodIdentifier, typename ...Verifiers>
+        void expectArg(Verifiers ... verifiers);
+
+        /**
+         * @brief Call dupeMethod in order to set the set the correct return value
+         * @note The duping is done in a composed way, calling dupeReturn won't override current dupe
+         * 
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @tparam ReturnType Return type of the function to mock
+         * @param ret return value to return when the mocked method is called
+         */
+        template <typename ClassMethodIdentifier, typename ReturnType>
+        void dupeReturn(ReturnType ret);
+
+        /**
+         * @brief Inject a latency into the given method: each call is delayed by a delay sampled from the distribution
+         *        (see Latency::onDelay in order to advance a clock instead of blocking the calling thread)
+         * @note The duping is done in a composed way, calling dupeLatency won't override current dupe
+         *
+         * @example
+         * @code
+         * fseamMock->dupeLatency<FSeam::ClassName::functionName>(FSeam::Latency::LogNormal{std::chrono::milliseconds(20), 0.5});
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param distribution distribution of the delays (Latency::Fixed, Latency::Uniform, Latency::LogNormal or Latency::Empirical)
+         */
+        template <typename ClassMethodIdentifier>
+        void dupeLatency(Latency::Distribution distribution) {
+            this->dupeMethod(ClassMethodIdentifier::NAME, [distribution = std::move(distribution)](void *) {
+                Latency::delay(Latency::sample(distribution));
+            }, true);
+        }
+
+        /**
+         * @brief Model a method as a server of a queueing model: when called by a client of the model (see
+         *        Queueing::Model::run), the call waits for a free slot of the server and takes its service time on the
+         *        virtual time line of the model. Called outside of a run, the method isn't delayed.
+         * @note The duping is done in a composed way, calling dupeServer won't override current dupe
+         *
+         * @example
+         * @code
+         * fseamMock->dupeServer<FSeam::ClassName::functionName>(model, {FSeam::Latency::Fixed{10ms}, 200});
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param model queueing model the server is part of
+         * @param server service time distribution and concurrency limit (number of requests served in parallel)
+         */
+        template <typename ClassMethodIdentifier>
+        void dupeServer(Queueing::Model &model, Queueing::Server server) {
+            this->dupeMethod(ClassMethodIdentifier::NAME, model.server(_className + ClassMethodIdentifier::NAME, std::move(server)), true);
+        }
+
+        /**
+         * @brief This method make it possible to dupe a method in order to have it do what you want.
+         *        This is a low level function that require the user to understand how the generated data struct
+         *        containing the function call metadata works (as this is the argument given to the handler)
+         * @note Duping an existing method doesn't remove the expectations attached to it.
+         *
+         * @param className name of the class to mock
+         * @param methodName method name to dupe
+         * @param handler dupped method that takes the data structure pointer. This data structure is a struct
+         *         that contains all the data for the called method (arguments, return values)
+         * @param isComposed if true, compose a new handler with the current one and the provided one,
+         *         if false, override the existing handler if any. Set at false by default
+         */
+        void dupeMethod(std::string methodName, const std::function<void(void*)> &handler, bool isComposed = false) {
+            auto methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            std::string key = _className + methodName;
+
+            if (_verifiers.find(key) != _verifiers.end())
+                methodCallVerifier = _verifiers.at(key);
+            methodCallVerifier->_methodName = std::move(methodName);
+            if (isComposed && methodCallVerifier->_handler) {
+                methodCallVerifier->_handler = [currentHandler = methodCallVerifier->_handler, handler](void *data){
+                    currentHandler(data);
+                    handler(data);
+                };
+            }
+            else {
+                methodCallVerifier->_called = 0;
+                methodCallVerifier->_handler = handler;
+            }
+            _verifiers[std::move(key)] = methodCallVerifier;
+        }
+
+        /**
+         * @brief Set the cost of a call to the given method, the cost is charged into the alive FSeam::Scope at each call
+         *
+         * @param methodName name of the method (Use the helpers constant to ensure no typo)
+         * @param cost function computing the cost of a call from the data structure of the call (same structure than
+         *        the one given to the dupeMethod handler, containing the arguments and the return value)
+         */
+        void setCost(std::string methodName, std::function<double(void*)> cost) {
+            std::shared_ptr<MethodCallVerifier> methodCallVerifier;
+            std::string key = _className + methodName;
+
+            if (_verifiers.find(key) != _verifiers.end())
+                methodCallVerifier = _verifiers.at(key);
+            else
+                methodCallVerifier = std::make_shared<MethodCallVerifier>();
+            methodCallVerifier->_methodName = std::move(methodName);
+            methodCallVerifier->_cost = std::move(cost);
+            _verifiers[std::move(key)] = methodCallVerifier;
+        }
+
+        /**
+         * @brief Set a fixed cost (weight) of a call to the given method
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         */
+        template <typename ClassMethodIdentifier>
+        void setCost(double weight) {
+            setCost(ClassMethodIdentifier::NAME, [weight](void *) { return weight; });
+        }
+
+        /**
+         * @brief Set the cost of a call to the given method as a function of the call data structure
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         */
+        template <typename ClassMethodIdentifier>
+        void setCost(std::function<double(void*)> cost) {
+            setCost(ClassMethodIdentifier::NAME, std::move(cost));
+        }
+
+        /**
+         * @brief Verify if the given method has been called at least one time
+         * 
+         * @param methodName Name of the method to check on the mock (Use the helpers constant to ensure no typo)
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if the method encounter the provided comparator conditions, false otherwise
+         */
+        bool verify(const std::string &methodName, bool verbose = true) const {
+            return verify(methodName, AtLeast(1), verbose);
+        }
+
+        /**
+         * @brief Verify if a method has been called under certain conditions (number of times)
+         * 
+         * @tparam Comparator  comparator class used, can be also an Integer, those comparator are defined under the namespace FSeam,
+         *          VerifyCompare/Integral value : Check if the method has been called exactly the number provided
+         *          NeverCalled : Check if the method has never been called
+         *          AtLeast : Check if the method has been called at least the number provided
+         *          AtMost  : Check if the method has been called at most the number provided
+         *          IsNot   : Check if the method is not the number provided
+         *          
+         * @param methodName Name of the method to check on the mock (Use the helpers constant to ensure no typo)
+         * @param comp comparator instance on which the number of times the mock method is called on a provided value
+         *         is checked against
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if the method encounter the provided comparator conditions, false otherwise
+         */
+        template <typename Comparator>
+        bool verify(std::string methodName, Comparator &&comp, bool verbose = true) const {
+            if constexpr (std::is_integral<Comparator>())
+                return verify(std::move(methodName), VerifyCompare{ static_cast<uint>(comp) }, verbose);
+            else {
+                static_assert(isCalledComparator<Comparator>::v, "Type  should be AtLeast, AtMost, Never, IsNot or VerifyCompare");
+                std::string key = _className + std::move(methodName);
+
+                auto it = _verifiers.find(key);
+
+                if (it == _verifiers.end()) {
+                    if (verbose && comp._toCompare > 0u) {
+                        Logging::Logger::report(Logging::VerifyFailure{std::move(key), &std::decay_t<Comparator>::describe,
+                                                                       static_cast<uint>(comp._toCompare), 0u, true});
+                    }
+                    return comp._toCompare == 0u;
+                }
+                const auto &methodCallVerifier = it->second;
+                bool result = comp.compare(methodCallVerifier->_called);
+                if (verbose && !result) {
+                    Logging::Logger::report(Logging::VerifyFailure{std::move(key), &std::decay_t<Comparator>::describe,
+                                                                   static_cast<uint>(comp._toCompare),
+                                                                   static_cast<uint>(methodCallVerifier->_called), false});
+                }
+                for (auto &expect : methodCallVerifier->_expectations)
+                    result &= expect();
+                return result;
+            }
+        }
+
+        /**
+         * @brief Get the redundant call report of a method (require report::enableRedundantCalls to be set before the calls)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @param topN maximum number of repeated argument tuples given in the report
+         * @return the redundant call report of the method, empty if never called
+         */
+        report::RedundantCall redundantCalls(const std::string &methodName, std::size_t topN = 5) const {
+            std::string key = _className + methodName;
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end())
+                return it->second->redundantCalls(std::move(key), topN);
+            report::RedundantCall result {};
+            result.key = std::move(key);
+            return result;
+        }
+
+        /**
+         * @brief Get the argument sketches of a method (require report::enableSketches to be set before the calls)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @return the sketches of the whole argument tuple and of each parameter, empty if never called
+         */
+        report::ArgumentSketches sketches(const std::string &methodName) const {
+            std::string key = _className + methodName;
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end()) {
+                report::ArgumentSketches result = it->second->_sketches;
+                result.key = std::move(key);
+                return result;
+            }
+            report::ArgumentSketches result {};
+            result.key = std::move(key);
+            return result;
+        }
+
+        /**
+         * @brief Replay the argument tuples of a method, in call order, through simulated caches of each given policy
+         *        and capacity (in a single pass), the argument tuple being the cache key. Tells the hit ratio to expect
+         *        from a cache in front of the dependency before writing it.
+         * @note require report::enableCacheSimulation to be set before the calls
+         *
+         * @example
+         * @code
+         * auto simulation = fseamMock->simulateCache<FSeam::ClassName::functionName>(FSeam::report::LRU | FSeam::report::TINY_LFU, {16, 64, 256});
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param policies combination of report::CachePolicy to simulate
+         * @param capacities capacities (in number of entries) simulated for each policy
+         * @return the hit ratio curve of each policy, empty if never called
+         */
+        template <typename ClassMethodIdentifier>
+        report::CacheSimulation simulateCache(unsigned policies, const std::vector<std::size_t> &capacities) const {
+            report::CacheSimulation result {};
+            result.key = _className + ClassMethodIdentifier::NAME;
+            auto it = _verifiers.find(result.key);
+            static const std::vector<std::uint64_t> empty;
+            const std::vector<std::uint64_t> &keys = it != _verifiers.end() ? it->second->_cacheKeys : empty;
+
+            if (it != _verifiers.end()) {
+                result.uncacheable = it->second->_uncacheableCalls;
+                result.calls = keys.size() + result.uncacheable;
+                result.distinct = std::unordered_set<std::uint64_t>(keys.begin(), keys.end()).size();
+            }
+            result.curves = report::internal::simulateCaches(keys, policies, capacities);
+            return result;
+        }
+
+        /**
+         * @brief Get the payload volume of a method (require report::enablePayload to be set before the calls)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @return bytes passed in and returned out by the method, empty if never called
+         */
+        report::Payload payload(const std::string &methodName) const {
+            std::string key = _className + methodName;
+            report::Payload result;
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end())
+                result = it->second->_payload;
+            result.key = std::move(key);
+            return result;
+        }
+
+        /**
+         * @brief Get the concurrency report of a method (require report::enableConcurrency to be set before the calls)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @return maximum number of calls in flight at the same time and overlap of the calls, empty if never called
+         */
+        report::Concurrency concurrency(const std::string &methodName) const {
+            std::string key = _className + methodName;
+            std::lock_guard<std::recursive_mutex> lock(_callMutex);
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end())
+                return it->second->concurrency(std::move(key));
+            return report::Concurrency{std::move(key)};
+        }
+
+        /**
+         * @brief Verify that at least minOverlap calls to a method have been in flight at the same time (a fan-out
+         *        expected to be parallel didn't regress into serial calls)
+         * @note require report::enableConcurrency to be set before the calls
+         *
+         * @example
+         * @code
+         * REQUIRE(fseamMock->verifyConcurrent<FSeam::ClassName::functionName>(3));
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param minOverlap minimum number of calls expected in flight at the same time
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if the maximum number of calls in flight is at least minOverlap, false otherwise
+         */
+        template <typename ClassMethodIdentifier>
+        bool verifyConcurrent(std::size_t minOverlap, bool verbose = true) const {
+            return verifyMaxInFlight<ClassMethodIdentifier>(AtLeast(static_cast<uint>(minOverlap)), verbose);
+        }
+
+        /**
+         * @brief Verify the maximum number of calls to a method in flight at the same time (AtMost to check a
+         *        concurrency limit, AtLeast for a fan-out)
+         * @note require report::enableConcurrency to be set before the calls
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param comparator VerifyCompare, AtMost, AtLeast, IsNot or NeverCalled applied on the maximum number of calls in flight
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if the maximum number of calls in flight matches the comparator, false otherwise
+         */
+        template <typename ClassMethodIdentifier, typename Comparator, typename = std::enable_if_t<isCalledComparator<Comparator>::v> >
+        bool verifyMaxInFlight(Comparator comparator, bool verbose = true) const {
+            report::Concurrency result = concurrency(ClassMethodIdentifier::NAME);
+            bool verified = comparator.compare(static_cast<uint>(result.maxInFlight));
+
+            if (verbose && !verified) {
+                std::ostringstream msg;
+                msg << "Verify concurrency error for method " << result.key << ", "
+                    << comparator.expectStr(static_cast<uint>(result.maxInFlight)) << " call(s) in flight at the same time ("
+                    << result.calls << " call(s), " << result.overlappedCalls << " overlapped)\n";
+                Logging::Logger::report(result.key, msg.str());
+            }
+            return verified;
+        }
+
+        /**
+         * @brief Get the chatty call report of a method (require report::enableChattyCalls to be set before the calls)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @return the chatty call report of the method, empty if never called
+         */
+        report::ChattyCall chattyCalls(const std::string &methodName) const {
+            std::string key = _className + methodName;
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end())
+                return it->second->chattyCalls(std::move(key));
+            report::ChattyCall result {};
+            result.key = std::move(key);
+            return result;
+        }
+
+        /**
+         * @brief Verify that a method is called in a batched way: no run of consecutive calls to the method (without
+         *        any other mocked call in between) is longer than maxRun
+         * @note require report::enableChattyCalls to be set before the calls
+         *
+         * @example
+         * @code
+         * fseamMock->verifyBatched<FSeam::DependencyGettable::checkSimpleInputVariable>(1);
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param maxRun maximum number of consecutive calls accepted
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if the longest run of consecutive calls is at most maxRun, false otherwise
+         */
+        template <typename ClassMethodIdentifier>
+        bool verifyBatched(std::size_t maxRun, bool verbose = true) const {
+            report::ChattyCall chatty = chattyCalls(ClassMethodIdentifier::NAME);
+            bool result = chatty.maxRun <= maxRun;
+
+            if (verbose && !result) {
+                std::string msg = "Verify batched error for method " + chatty.key + ", we expected at most " +
+                        std::to_string(maxRun) + " consecutive calls but received a run of " + std::to_string(chatty.maxRun) +
+                        " (" + std::to_string(chatty.calls) + " calls in " + std::to_string(chatty.runs) + " runs)\n";
+                Logging::Logger::report(chatty.key, std::move(msg));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Record the calls of a spied method into the given recorder (the header of the class has to be spied,
+         *        see TO_SPY): arguments and return value are appended to the record file
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param recorder recorder of the file, can be shared between methods
+         */
+        template <typename ClassMethodIdentifier>
+        void record(std::shared_ptr<Record::Recorder> recorder) {
+            _recorders[_className + ClassMethodIdentifier::NAME] = std::move(recorder);
+        }
+
+        /**
+         * @brief Serve the return values of a mocked method from a record file, a call without any record left keeps
+         *        the return value set by dupeReturn (or the default one)
+         *
+         * @example
+         * @code
+         * auto replayer = std::make_shared<FSeam::Record::Replayer>("dependency.fseamrec");
+         * fseamMock->replay<FSeam::DependencyGettable::checkSimpleReturnValue>(replayer, FSeam::Record::Mode::BY_ARGS);
+         * @endcode
+         *
+         * @tparam ClassMethodIdentifier identifier structure generated by FSeam which represent a specific method of a specific class
+         * @param replayer replayer of the file, can be shared between methods
+         * @param mode serve the records in order, or in order for the calls with the same arguments
+         */
+        template <typename ClassMethodIdentifier>
+        void replay(std::shared_ptr<Record::Replayer> replayer, Record::Mode mode = Record::Mode::IN_ORDER) {
+            _replayers[_className + ClassMethodIdentifier::NAME] = {std::move(replayer), mode};
+        }
+
+        /**
+         * @brief Get the spy call report of a method (the header of the class has to be spied, see TO_SPY)
+         *
+         * @param methodName Name of the method (Use the helpers constant to ensure no typo)
+         * @return number of calls and time spent into the original implementation of the method, empty if never called
+         */
+        report::SpyCall spyCalls(const std::string &methodName) const {
+            std::string key = _className + methodName;
+
+            if (auto it = _verifiers.find(key); it != _verifiers.end()) {
+                report::SpyCall result = it->second->_spy;
+                result.key = std::move(key);
+                return result;
+            }
+            return report::SpyCall{std::move(key)};
+        }
+
+        const std::string &className() const { return _className; }
+
+        /**
+         * @brief Call the visitor with the key and the MethodCallVerifier of each method registered on this mock
+         */
+        template <typename Visitor>
+        void forEachMethod(Visitor &&visitor) const {
+            for (const auto &[key, methodCallVerifier] : _verifiers)
+                visitor(key, *methodCallVerifier);
+        }
+
+    private:
+        std::string _className;
+        std::map<std::string, std::shared_ptr<MethodCallVerifier> > _verifiers;
+        // protect _verifiers against the mocked calls done by several threads (the dupe handlers are called unlocked)
+        mutable std::recursive_mutex _callMutex;
+        std::map<std::string, std::shared_ptr<Record::Recorder> > _recorders;
+        std::map<std::string, std::pair<std::shared_ptr<Record::Replayer>, Record::Mode> > _replayers;
+    };
+
+    /**
+     * @brief Mocking singleton, this is the main class of FSeam class contains all the mock
+     */
+    class MockVerifier {
+        inline static std::unique_ptr<MockVerifier> inst = nullptr;
+        // the mocked calls of several threads (fan-out to different mocks) register their mock concurrently
+        inline static std::recursive_mutex _registryMutex;
+
+    public:
+        MockVerifier() = default;
+        ~MockVerifier() = default;
+
+        static MockVerifier &instance() {
+            std::lock_guard<std::recursive_mutex> lock(_registryMutex);
+            if (inst == nullptr) {
+                inst = std::make_unique<MockVerifier>();
+            };
             return *(inst.get());
         }
 
         /**
-         * @brief Clean the FSeam context of all previously set mock behaviors
+         * @brief Clean the FSeam context of all previously set mock behaviors
+         */
+        static void cleanUp() {
+            if (inst && Metrics::isEnabled())
+                inst->accumulateMetrics();
+            Logging::Logger::flush();
+            {
+                std::lock_guard<std::mutex> lock(MethodCallVerifier::_sequenceMutex);
+                MethodCallVerifier::_lastCalled.reset();
+            }
+            report::internal::TransitionTracker::reset();
+            inst.reset(nullptr);
+        }
+
+        bool isMockRegistered(const void *mockPtr) {
+            std::lock_guard<std::recursive_mutex> lock(_registryMutex);
+            return this->_mockedClass.find(mockPtr) != this->_mockedClass.end();
+        }
+
+        /**
+         * @brief This method get the MockClassVerifier instance class
+         * @details Method that retrieve the FSeam MockClassVerifier instance class corresponding to the pointer given as parameter
+         *
+         * @param mockPtr pointer on the instance to mock
+         * @param classMockName name of the class to mock (provided by TypeParseTraits)
+         * @return a MockClassVerifier shared_ptr class, if not referenced yet, create one by calling the ::addMock(T) method
+         */
+        std::shared_ptr<MockClassVerifier> &getMock(const void *mockPtr, const std::string &classMockName) {
+            std::lock_guard<std::recursive_mutex> lock(_registryMutex);
+            if (!isMockRegistered(mockPtr))
+                return addMock(mockPtr, classMockName);
+            return this->_mockedClass.at(mockPtr);
+        }
+
+        /**
+         * @brief This method get the default MockClassVerifier for a class type
+         * @details Method that retrieve the default MockClassVerifier instance class corresponding to type given as template parameter
+         *
+         * @param classMockName name of the class to mock (provided by FSeam::TypeParseTraits)
+         * @return a MockClassVerifier shared_ptr class, if not referenced yet, create one by calling the ::addDefaultMock(T) method
+         */
+        std::shared_ptr<MockClassVerifier> &getDefaultMock(const std::string &classMockName) {
+            std::lock_guard<std::recursive_mutex> lock(_registryMutex);
+            if (this->_defaultMockedClass.find(classMockName) == this->_defaultMockedClass.end())
+                return addDefaultMock(classMockName);
+            return this->_defaultMockedClass.at(classMockName);
+        }
+
+        /**
+         * @brief Call the visitor on each registered MockClassVerifier (instance mocks first, then default mocks)
+         */
+        template <typename Visitor>
+        void forEachMock(Visitor &&visitor) const {
+            std::lock_guard<std::recursive_mutex> lock(_registryMutex);
+            for (const auto &[ptr, mock] : _mockedClass)
+                visitor(*mock);
+            for (const auto &[className, mock] : _defaultMockedClass)
+                visitor(*mock);
+        }
+
+        /**
+         * @brief Accumulate the metrics of the mocked calls done since the last cleanUp into the process metrics
+         */
+        void accumulateMetrics() const {
+            forEachMock([](const MockClassVerifier &mock) {
+                mock.forEachMethod([&mock](const std::string &, const MethodCallVerifier &method) {
+                    if (!method._called)
+                        return;
+                    Metrics::MethodMetrics metrics {mock.className(), method._methodName, method._called, 0, method._capturedBytes};
+                    for (const auto &expectation : method._expectations)
+                        metrics.expectationHits += expectation._numberTimeMatched;
+                    Metrics::internal::accumulate(metrics);
+                });
+            });
+        }
+
+    private:
+        std::shared_ptr<MockClassVerifier> &addMock(const void *mockPtr, const std::string &className) {
+            this->_mockedClass[mockPtr] = std::make_shared<MockClassVerifier>(className);
+            return this->_mockedClass.at(mockPtr);
+        }
+        std::shared_ptr<MockClassVerifier> &addDefaultMock(const std::string &className) {
+            this->_defaultMockedClass[className] = std::make_shared<MockClassVerifier>(className);
+            return this->_defaultMockedClass.at(className);
+        }
+
+    private:
+        std::map<const void*, std::shared_ptr<MockClassVerifier> > _mockedClass;
+        std::map<std::string, std::shared_ptr<MockClassVerifier> > _defaultMockedClass;
+    };
+
+    // ------------------------ Helper Client Free functions --------------------------
+
+    /**
+     * @brief This method get the MockClassVerifier instance class
+     * @details Method that retrieve the mock verifier instance class corresponding to the pointer given as parameter
+     *
+     * @tparam T type of the instance to mock
+     * @param mockPtr pointer on the instance to mock
+     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     */
+    template <typename T>
+    std::shared_ptr<MockClassVerifier> &get(const T *mockPtr) {
+        return FSeam::MockVerifier::instance().getMock(mockPtr, TypeParseTraits<T>::ClassName);
+    }
+
+    /**
+     * @brief This method get the MockClassVerifier instance for the given class type
+     * @details Get the Default MockClassVerifier correspond to the class template
+     *          This method has to be used in order to set default behaviors on a class type without needing to access
+     *          the actual instance you want to mock
+     *
+     * @tparam T Class type that is going to be default mocked
+     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     */
+    template <typename T>
+    std::shared_ptr<MockClassVerifier> &getDefault() {
+        return FSeam::MockVerifier::instance().getDefaultMock(TypeParseTraits<T>::ClassName);
+    }
+
+    /**
+     * @brief This method get the MockClassVerifier instance for the static / free functions calls
+     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     */
+    template<typename T = void>
+    std::shared_ptr<MockClassVerifier> &getFreeFunc() {
+        return getDefault<void>();
+    }
+
+    /**
+     * @brief Verify the number of heap allocations counted into the scope (requires the allocation seam)
+     *
+     * @example
+     * @code
+     * REQUIRE(FSeam::verifyAllocations(scope, FSeam::AtMost(0)));
+     * @endcode
+     *
+     * @param scope scope in which the allocations have been counted
+     * @param comparator VerifyCompare, AtMost, AtLeast, IsNot or NeverCalled applied on the number of allocations
+     * @param verbose flag if a debug string is required in case of false response (set to true by default)
+     * @return true if the number of allocations matches the comparator, false otherwise
+     */
+    template <typename Comparator, typename = std::enable_if_t<isCalledComparator<Comparator>::v> >
+    bool verifyAllocations(const AllocationScope &scope, Comparator comparator, bool verbose = true) {
+        const AllocationScope::Counters &counters = scope.counters();
+        bool result = comparator.compare(static_cast<uint>(counters.allocations));
+
+        if (verbose && !result) {
+            std::string msg = "Verify allocations error for scope " + scope.name() + ", " +
+                    comparator.expectStr(static_cast<uint>(counters.allocations)) + " (allocations, " +
+                    std::to_string(counters.bytes) + " bytes, peak of " + std::to_string(counters.peakLiveBytes) + " live bytes)\n";
+            Logging::Logger::report(scope.name(), std::move(msg));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Verify the number of syscalls counted into the scope against a budget (requires the syscall seam)
+     *
+     * @example
+     * @code
+     * REQUIRE(FSeam::verifySyscalls(scope, {{"fsync", FSeam::AtMost(1)}, {"write", FSeam::AtMost(4)}}));
+     * @endcode
+     *
+     * @param scope scope in which the syscalls have been counted
+     * @param budget comparator (VerifyCompare, AtMost, AtLeast, IsNot or NeverCalled) per syscall name (read, write,
+     *        pread, pwrite, fsync, fdatasync, mmap, clock_gettime, epoll_wait)
+     * @param verbose flag if a debug string is required in case of false response (set to true by default)
+     * @return true if each syscall of the budget matches its comparator, false otherwise
+     */
+    inline bool verifySyscalls(const SyscallScope &scope, std::initializer_list<std::pair<std::string, MethodCallVerifier::CalledCompare> > budget,
+                               bool verbose = true) {
+        bool result = true;
+
+        for (const auto &[name, comparator] : budget) {
+            std::size_t index = 0;
+            while (index < static_cast<std::size_t>(Syscall::COUNT) && syscallName(static_cast<Syscall>(index)) != name)
+                ++index;
+            if (index == static_cast<std::size_t>(Syscall::COUNT)) {
+                Logging::Logger::report(scope.name(), "Verify syscalls error for scope " + scope.name() + ", " + name +
+                        " is not a syscall counted by FSeam\n");
+                result = false;
+                continue;
+            }
+            const SyscallCount &count = scope.counters()[static_cast<Syscall>(index)];
+            auto calls = static_cast<uint>(count.calls);
+            bool matches = std::visit([calls](const auto &comp) { return comp.compare(calls); }, comparator);
+
+            if (verbose && !matches) {
+                std::string msg = "Verify syscalls error for scope " + scope.name() + " on " + name + ", " +
+                        std::visit([calls](const auto &comp) { return comp.expectStr(calls); }, comparator) +
+                        " (" + std::to_string(count.bytes) + " bytes)\n";
+                Logging::Logger::report(scope.name(), std::move(msg));
+            }
+            result = result && matches;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Verify the number of lock acquisitions counted into the scope (requires the lock seam)
+     *
+     * @example
+     * @code
+     * REQUIRE(FSeam::verifyLocks(scope, FSeam::AtMost(2)));
+     * @endcode
+     *
+     * @param scope scope in which the locks have been counted
+     * @param comparator VerifyCompare, AtMost, AtLeast, IsNot or NeverCalled applied on the number of acquisitions
+     * @param verbose flag if a debug string (with the stats per mutex) is required in case of false response
+     * @return true if the number of acquisitions matches the comparator, false otherwise
+     */
+    template <typename Comparator, typename = std::enable_if_t<isCalledComparator<Comparator>::v> >
+    bool verifyLocks(const LockScope &scope, Comparator comparator, bool verbose = true) {
+        const LockScope::Counters &counters = scope.counters();
+        bool result = comparator.compare(static_cast<uint>(counters.total.acquisitions));
+
+        if (verbose && !result) {
+            std::ostringstream msg;
+            msg << "Verify locks error for scope " << scope.name() << ", "
+                << comparator.expectStr(static_cast<uint>(counters.total.acquisitions)) << " (acquisitions, "
+                << counters.total.contended << " contended)\n";
+            for (std::size_t i = 0; i < counters.size; ++i) {
+                const auto &[address, stats] = counters.locks[i];
+                msg << "  " << address << " : " << stats.acquisitions << " acquisition(s), " << stats.contended
+                    << " contended, held " << stats.held.count() << "ns (max " << stats.maxHeld.count() << "ns)";
+                if (stats.waits || stats.signals)
+                    msg << ", " << stats.waits << " wait(s), " << stats.signals << " signal(s)";
+                msg << "\n";
+            }
+            Logging::Logger::report(scope.name(), msg.str());
+        }
+        return result;
+    }
+
+    namespace Metrics {
+
+        /**
+         * @return the metrics accumulated since the start of the test binary, including the mocked calls done since the
+         *         last cleanUp
+         */
+        inline std::vector<MethodMetrics> snapshot() {
+            std::map<std::pair<std::string, std::string>, MethodMetrics> totals;
+            {
+                std::lock_guard<std::mutex> lock(internal::mutex);
+                totals = internal::totals;
+            }
+            MockVerifier::instance().forEachMock([&totals](const MockClassVerifier &mock) {
+                mock.forEachMethod([&totals, &mock](const std::string &, const MethodCallVerifier &method) {
+                    if (!method._called)
+                        return;
+                    MethodMetrics &total = totals[{mock.className(), method._methodName}];
+                    total.className = mock.className();
+                    total.methodName = method._methodName;
+                    total.calls += method._called;
+                    total.capturedBytes += method._capturedBytes;
+                    for (const auto &expectation : method._expectations)
+                        total.expectationHits += expectation._numberTimeMatched;
+                });
+            });
+            std::vector<MethodMetrics> result;
+            for (auto &[key, metrics] : totals)
+                result.emplace_back(std::move(metrics));
+            return result;
+        }
+
+        /**
+         * @brief Write the metrics in the given format
+         * @param binary name of the test binary, written as a label of the metrics
+         * @param shard name of the shard (process) of the test binary, written as a label of the metrics
+         */
+        inline bool write(const std::string &path, Format format, const std::string &binary, const std::string &shard) {
+            std::ofstream file(path, std::ios::trunc);
+            std::vector<MethodMetrics> metrics = snapshot();
+
+            if (!file) {
+                Logging::Logger::log(Logging::Level::ERROR, "Metrics file " + path + " can't be opened\n");
+                return false;
+            }
+            if (format == Format::JSON) {
+                file << "{\"binary\":\"" << binary << "\",\"shard\":\"" << shard << "\",\"methods\":[";
+                for (std::size_t i = 0; i < metrics.size(); ++i) {
+                    file << (i ? ",\n" : "\n") << "{\"class\":\"" << metrics[i].className << "\",\"method\":\"" << metrics[i].methodName
+                         << "\",\"calls\":" << metrics[i].calls << ",\"expectationHits\":" << metrics[i].expectationHits
+                         << ",\"capturedBytes\":" << metrics[i].capturedBytes << "}";
+                }
+                file << "\n]}\n";
+            }
+            else {
+                auto family = [&file, &metrics, &binary, &shard](const std::string &name, const std::string &help, auto value) {
+                    file << "# TYPE " << name << " counter\n# HELP " << name << " " << help << "\n";
+                    for (const auto &method : metrics) {
+                        file << name << "_total{binary=\"" << binary << "\",shard=\"" << shard << "\",class=\"" << method.className
+                             << "\",method=\"" << method.methodName << "\"} " << value(method) << "\n";
+                    }
+                };
+                family("fseam_mock_calls", "Number of calls of the mocked method", [](const MethodMetrics &m) { return m.calls; });
+                family("fseam_mock_expectation_hits", "Number of calls matching an expectation", [](const MethodMetrics &m) { return m.expectationHits; });
+                family("fseam_mock_captured_bytes", "Number of bytes captured by the arguments", [](const MethodMetrics &m) { return m.capturedBytes; });
+                file << "# EOF\n";
+            }
+            return file.good();
+        }
+
+        namespace internal {
+            /**
+             * @return file name of the running executable (/proc/self/exe, /proc/self/comm being truncated to 15 characters)
+             */
+            inline std::string binaryName() {
+                std::array<char, 4096> path {};
+                ssize_t size = readlink("/proc/self/exe", path.data(), path.size() - 1);
+
+                if (size <= 0)
+                    return "fseam";
+                std::string_view name(path.data(), static_cast<std::size_t>(size));
+                if (auto slash = name.rfind('/'); slash != std::string_view::npos)
+                    name.remove_prefix(slash + 1);
+                return name.empty() ? "fseam" : std::string(name);
+            }
+
+            /**
+             * @return path of the metrics file: <directory>/<binary>-<shard>.fseam-metrics.(json|prom), the shard being the
+             *         FSEAM_METRICS_SHARD environment variable if set, the process id otherwise
+             */
+            inline std::string path(const std::string &binary, const std::string &shard) {
+                return directory + "/" + binary + "-" + shard + (format == Format::JSON ? ".fseam-metrics.json" : ".fseam-metrics.prom");
+            }
+
+            inline std::string shard() {
+                const char *shard = std::getenv("FSEAM_METRICS_SHARD");
+                return shard ? std::string(shard) : std::to_string(::getpid());
+            }
+        }
+
+        /**
+         * @brief Enable the metrics, they are written into the given directory at the exit of the test binary
+         *        (see internal::path for the file name). Also enabled by the FSEAM_METRICS_DIR environment variable
+         *        (and FSEAM_METRICS_FORMAT=openmetrics), without any change in the tests.
+         */
+        inline void enable(const std::string &directory, Format format = Format::JSON, bool enable = true) {
+            static const bool writeAtExit = [] {
+                return std::atexit([] {
+                    if (isEnabled() && !internal::directory.empty()) {
+                        std::string binary = internal::binaryName();
+                        std::string shard = internal::shard();
+                        write(internal::path(binary, shard), internal::format, binary, shard);
+                    }
+                }) == 0;
+            }();
+
+            (void)writeAtExit;
+            internal::directory = directory;
+            internal::format = format;
+            internal::enabled = enable;
+        }
+
+        namespace internal {
+            inline const bool enabledFromEnvironment = [] {
+                const char *directory = std::getenv("FSEAM_METRICS_DIR");
+                const char *format = std::getenv("FSEAM_METRICS_FORMAT");
+
+                if (!directory || !*directory)
+                    return false;
+                enable(directory, (format && std::string(format) == "openmetrics") ? Format::OPEN_METRICS : Format::JSON);
+                return true;
+            }();
+        }
+
+    }
+
+    /**
+     * @brief Verify that the cost of the mocked calls accounted into the scope (see MockClassVerifier::setCost) is in the budget
+     *
+     * @param scope scope in which the mocked calls costs have been accounted
+     * @param limit maximum cost accepted
+     * @param verbose flag if a debug string (with a per method cost breakdown) is required in case of false response
+     * @return true if the cost accounted into the scope is lower or equal to limit, false otherwise
+     */
+    inline bool verifyCostBudget(const Scope &scope, double limit, bool verbose = true) {
+        bool result = scope.cost() <= limit;
+
+        if (verbose && !result) {
+            std::string msg = "Cost budget error for scope " + scope.name() + ", we expected at most " + std::to_string(limit) +
+                    " but the mocked calls cost " + std::to_string(scope.cost()) + "\n";
+            for (const auto &[key, methodCost] : scope.costs())
+                msg += "  " + key + " : " + std::to_string(methodCost.calls) + " call(s) for " + std::to_string(methodCost.cost) + "\n";
+            Logging::Logger::report(scope.name(), std::move(msg));
+        }
+        return result;
+    }
+
+    /**
+     * @brief In-memory file system used by the file I/O seam (seams/fileio.cc, linked with addFSeamTests(... SEAMS fileio))
+     * @details When enabled, open, read, write, pread, pwrite, lseek, fsync, fdatasync and close on a path under the
+     *          mounted root are served from memory: no disk access, and a syscall of the code under test is a mocked call
+     *          on the mock of the file (MemoryFs::file) and on the mock of the whole file system (MemoryFs::all).
+     *          Those mocks are regular MockClassVerifier, the syscalls are verified, duped (error injection by setting
+     *          MemoryFs::Data::error) or delayed (dupeLatency) through the method identifiers of FSeam::MemoryFile.
+     *          Paths outside of the root and descriptors not opened by the seam are forwarded to the kernel.
+     * @note The files are kept across MockVerifier::cleanUp (the mocks are not), MemoryFs::reset removes them.
+     */
+    namespace MemoryFs {
+
+        /**
+         * @brief Data structure given to the handlers duping a syscall of the seam (dupeMethod), and to expectations
          */
-        static void cleanUp() {
-            inst.reset(nullptr);
+        struct Data {
+            std::string path;
+            int fd = -1;
+            std::size_t bytes = 0;   // bytes requested on entry, bytes transferred on exit (read / write calls)
+            int error = 0;           // set it from a duped handler to make the syscall fail with this errno
+        };
+
+        namespace internal {
+            inline std::atomic<bool> enabled {false};
+            inline std::mutex mutex;
+            inline std::string root;    // without trailing '/', empty for the whole file system
+            inline std::map<std::string, std::shared_ptr<std::string> > files;
+            inline std::map<std::string, char> mockKeys;
         }
 
-        bool isMockRegistered(const void *mockPtr) {
-            return this->_mockedClass.find(mockPtr) != this->_mockedClass.end();
+        inline bool isEnabled() {
+            return internal::enabled.load(std::memory_order_relaxed);
         }
 
         /**
-         * @brief This method get the MockClassVerifier instance class
-         * @details Method that retrieve the FSeam MockClassVerifier instance class corresponding to the pointer given as parameter
-         *
-         * @param mockPtr pointer on the instance to mock
-         * @param classMockName name of the class to mock (provided by TypeParseTraits)
-         * @return a MockClassVerifier shared_ptr class, if not referenced yet, create one by calling the ::addMock(T) method
+         * @brief Enable the in-memory file system for the paths under the root directory (root itself included)
          */
-        std::shared_ptr<MockClassVerifier> &getMock(const void *mockPtr, const std::string &classMockName) {
-            if (!isMockRegistered(mockPtr))
-                return addMock(mockPtr, classMockName);
-            return this->_mockedClass.at(mockPtr);
+        inline void enable(std::string root = "/", bool enable = true) {
+            while (!root.empty() && root.back() == '/')
+                root.pop_back();
+            {
+                std::lock_guard<std::mutex> lock(internal::mutex);
+                internal::root = std::move(root);
+            }
+            internal::enabled = enable;
         }
 
         /**
-         * @brief This method get the default MockClassVerifier for a class type
-         * @details Method that retrieve the default MockClassVerifier instance class corresponding to type given as template parameter
-         *
-         * @param classMockName name of the class to mock (provided by FSeam::TypeParseTraits)
-         * @return a MockClassVerifier shared_ptr class, if not referenced yet, create one by calling the ::addDefaultMock(T) method
+         * @return true if the path is served by the in-memory file system
          */
-        std::shared_ptr<MockClassVerifier> &getDefaultMock(const std::string &classMockName) {
-            if (this->_defaultMockedClass.find(classMockName) == this->_defaultMockedClass.end())
-                return addDefaultMock(classMockName);
-            return this->_defaultMockedClass.at(classMockName);
+        inline bool isManaged(const char *path) {
+            if (!isEnabled() || !path)
+                return false;
+            std::string_view candidate(path);
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            const std::string &root = internal::root;
+
+            // component-wise: "/tmp/db" manages "/tmp/db" and "/tmp/db/..." but not "/tmp/db-backup/..."
+            return candidate.substr(0, root.size()) == root &&
+                   (candidate.size() == root.size() ? !root.empty() : candidate[root.size()] == '/');
         }
 
-    private:
-        std::shared_ptr<MockClassVerifier> &addMock(const void *mockPtr, const std::string &className) {
-            this->_mockedClass[mockPtr] = std::make_shared<MockClassVerifier>(className);
-            return this->_mockedClass.at(mockPtr);
+        /**
+         * @brief Create (or replace) a file of the in-memory file system
+         */
+        inline void add(const std::string &path, std::string content = "") {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            internal::files[path] = std::make_shared<std::string>(std::move(content));
         }
-        std::shared_ptr<MockClassVerifier> &addDefaultMock(const std::string &className) {
-            this->_defaultMockedClass[className] = std::make_shared<MockClassVerifier>(className);
-            return this->_defaultMockedClass.at(className);
+
+        /**
+         * @return content of the file, std::nullopt if the file doesn't exist
+         */
+        inline std::optional<std::string> content(const std::string &path) {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            auto it = internal::files.find(path);
+
+            if (it == internal::files.end())
+                return std::nullopt;
+            return *it->second;
         }
 
-    private:
-        std::map<const void*, std::shared_ptr<MockClassVerifier> > _mockedClass;
-        std::map<std::string, std::shared_ptr<MockClassVerifier> > _defaultMockedClass;
-    };
+        /**
+         * @brief Remove all the files, the descriptors still opened keep working on their file
+         */
+        inline void reset() {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            internal::files.clear();
+        }
 
-    // ------------------------ Helper Client Free functions --------------------------
+        /**
+         * @return the mock on which the syscalls on the given path are registered (the file doesn't have to exist)
+         */
+        inline std::shared_ptr<MockClassVerifier> &file(const std::string &path) {
+            const void *key;
+            {
+                std::lock_guard<std::mutex> lock(internal::mutex);
+                key = &internal::mockKeys[path];
+            }
+            return MockVerifier::instance().getMock(key, "MemoryFile");
+        }
+
+        /**
+         * @return the mock on which the syscalls on every path of the in-memory file system are registered
+         */
+        inline std::shared_ptr<MockClassVerifier> &all() {
+            return MockVerifier::instance().getDefaultMock("MemoryFs");
+        }
+
+    }
 
     /**
-     * @brief This method get the MockClassVerifier instance class
-     * @details Method that retrieve the mock verifier instance class corresponding to the pointer given as parameter
-     *
-     * @tparam T type of the instance to mock
-     * @param mockPtr pointer on the instance to mock
-     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     * @brief Method identifiers of the syscalls served by the file I/O seam (to use with the MemoryFs mocks)
      */
-    template <typename T>
-    std::shared_ptr<MockClassVerifier> &get(const T *mockPtr) {
-        return FSeam::MockVerifier::instance().getMock(mockPtr, TypeParseTraits<T>::ClassName);
+    namespace MemoryFile {
+        struct open { inline static const std::string NAME = "open"; };
+        struct read { inline static const std::string NAME = "read"; };
+        struct write { inline static const std::string NAME = "write"; };
+        struct pread { inline static const std::string NAME = "pread"; };
+        struct pwrite { inline static const std::string NAME = "pwrite"; };
+        struct lseek { inline static const std::string NAME = "lseek"; };
+        struct fsync { inline static const std::string NAME = "fsync"; };
+        struct fdatasync { inline static const std::string NAME = "fdatasync"; };
+        struct close { inline static const std::string NAME = "close"; };
     }
 
     /**
-     * @brief This method get the MockClassVerifier instance for the given class type
-     * @details Get the Default MockClassVerifier correspond to the class template
-     *          This method has to be used in order to set default behaviors on a class type without needing to access
-     *          the actual instance you want to mock
-     *
-     * @tparam T Class type that is going to be default mocked
-     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     * @brief In-process network stand-in used by the socket seam (seams/socket.cc, linked with addFSeamTests(... SEAMS socket))
+     * @details When enabled, the AF_INET / AF_INET6 sockets are served in process: connect, send and sendto reach the
+     *          stand-in server listening at the address (Network::listen), which answers synchronously, and recv /
+     *          recvfrom / epoll_wait see its responses. The link of a stand-in simulates a bandwidth and a latency (applied
+     *          with Latency::delay on send, so virtual with Latency::onDelay or the clock seam) and splits the stream into
+     *          segments (each recv returns at most one segment).
+     *          Each call is a mocked call on the mock of the stand-in (Network::server) and on the mock of the whole
+     *          network (Network::all), verified, duped or delayed through the method identifiers of FSeam::Socket.
+     * @note The stand-ins are kept across MockVerifier::cleanUp (the mocks are not), Network::reset removes them.
      */
-    template <typename T>
-    std::shared_ptr<MockClassVerifier> &getDefault() {
-        return FSeam::MockVerifier::instance().getDefaultMock(TypeParseTraits<T>::ClassName);
+    namespace Network {
+
+        /**
+         * @brief Data structure given to the handlers duping a call of the seam (dupeMethod), and to expectations
+         */
+        struct Data {
+            std::string address;
+            int fd = -1;
+            std::size_t bytes = 0;   // bytes requested on entry, bytes transferred on exit (send / recv calls)
+            int error = 0;           // set it from a duped handler to make the call fail with this errno
+        };
+
+        /**
+         * @brief Simulated link between the client sockets and a stand-in server
+         */
+        struct Link {
+            std::uint64_t bandwidth = 0;                  // bytes per second, 0 for an unlimited bandwidth
+            std::optional<Latency::Distribution> latency; // delay added to each send
+            std::size_t segmentSize = 0;                  // maximum bytes returned by a recv on a stream, 0 for no split
+        };
+
+        /**
+         * @brief Stand-in server handler: called with the bytes of each send (or datagram), returns the bytes to send back
+         */
+        using Handler = std::function<std::string(std::string_view received)>;
+
+        struct Traffic {
+            std::size_t connections = 0;
+            std::size_t sent = 0;       // bytes sent by the clients to the stand-in
+            std::size_t received = 0;   // bytes received by the clients from the stand-in
+        };
+
+        namespace internal {
+            struct Server {
+                Handler handler;
+                Link link;
+                Traffic traffic;
+            };
+
+            inline std::atomic<bool> enabled {false};
+            inline std::mutex mutex;
+            inline std::map<std::string, std::shared_ptr<Server> > servers;
+            inline std::map<std::string, char> mockKeys;
+        }
+
+        inline bool isEnabled() {
+            return internal::enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Enable the network stand-in, the sockets created while enabled are served in process
+         */
+        inline void enable(bool enable = true) {
+            internal::enabled = enable;
+        }
+
+        /**
+         * @brief Register (or replace) the stand-in server listening at the address
+         * @param address "ip:port" for IPv4, "[ip]:port" for IPv6 (127.0.0.1:8080, [::1]:8080)
+         */
+        inline void listen(const std::string &address, Handler handler, Link link = {}) {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            internal::servers[address] = std::make_shared<internal::Server>(internal::Server{std::move(handler), std::move(link), {}});
+        }
+
+        /**
+         * @return bytes and connections through the stand-in listening at the address since it has been registered
+         */
+        inline Traffic traffic(const std::string &address) {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            auto it = internal::servers.find(address);
+
+            return it == internal::servers.end() ? Traffic{} : it->second->traffic;
+        }
+
+        /**
+         * @brief Remove all the stand-in servers
+         */
+        inline void reset() {
+            std::lock_guard<std::mutex> lock(internal::mutex);
+            internal::servers.clear();
+        }
+
+        /**
+         * @return the mock on which the calls to the given address are registered (no stand-in has to listen on it)
+         */
+        inline std::shared_ptr<MockClassVerifier> &server(const std::string &address) {
+            const void *key;
+            {
+                std::lock_guard<std::mutex> lock(internal::mutex);
+                key = &internal::mockKeys[address];
+            }
+            return MockVerifier::instance().getMock(key, "NetworkServer");
+        }
+
+        /**
+         * @return the mock on which every call of the seam is registered (socket and epoll calls included)
+         */
+        inline std::shared_ptr<MockClassVerifier> &all() {
+            return MockVerifier::instance().getDefaultMock("Network");
+        }
+
     }
 
     /**
-     * @brief This method get the MockClassVerifier instance for the static / free functions calls
-     * @return the mock verifier instance class, if not referenced yet, create one by calling the ::addMock(T) method
+     * @brief Method identifiers of the calls served by the socket seam (to use with the Network mocks)
      */
-    template<typename T = void>
-    std::shared_ptr<MockClassVerifier> &getFreeFunc() {
-        return getDefault<void>();
+    namespace Socket {
+        struct socket { inline static const std::string NAME = "socket"; };
+        struct connect { inline static const std::string NAME = "connect"; };
+        struct send { inline static const std::string NAME = "send"; };
+        struct recv { inline static const std::string NAME = "recv"; };
+        struct epoll_ctl { inline static const std::string NAME = "epoll_ctl"; };
+        struct epoll_wait { inline static const std::string NAME = "epoll_wait"; };
+    }
+
+    // ------------------------ Call analysis reports --------------------------
+
+    namespace report {
+
+        /**
+         * @brief Enable the redundant call analysis: arguments of each mocked call are hashed in order to find the
+         *        methods called several time with the same arguments (memoization opportunities in the tested code)
+         * @note Arguments have to be hashable (std::hash or FSeam::ArgHash specialization), calls with a non hashable
+         *       argument are not analysed
+         */
+        inline void enableRedundantCalls(bool enable = true) {
+            Settings::redundantCalls = enable;
+        }
+
+        /**
+         * @brief Get the redundant call report of all the mocked methods called since the last cleanUp
+         *
+         * @param minDuplicateRatio only the methods with a duplicate call ratio higher or equal are reported
+         * @param topN maximum number of repeated argument tuples given for each method
+         * @return reports sorted by decreasing duplicate call ratio
+         */
+        inline std::vector<RedundantCall> redundantCalls(double minDuplicateRatio = 0., std::size_t topN = 5) {
+            std::vector<RedundantCall> reports;
+
+            MockVerifier::instance().forEachMock([&reports, minDuplicateRatio, topN](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports, minDuplicateRatio, topN](const std::string &key, const MethodCallVerifier &method) {
+                    RedundantCall redundant = method.redundantCalls(key, topN);
+                    if (redundant.calls && redundant.duplicateRatio() >= minDuplicateRatio)
+                        reports.emplace_back(std::move(redundant));
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.duplicateRatio() > rhs.duplicateRatio();
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Enable the chatty call analysis: runs of consecutive calls to the same mocked method (without any other
+         *        mocked call in between) are recorded, which reveal the loops that could use a batched API (N+1 pattern)
+         */
+        inline void enableChattyCalls(bool enable = true) {
+            Settings::chattyCalls = enable;
+        }
+
+        /**
+         * @brief Get the chatty call report of all the mocked methods called since the last cleanUp
+         *
+         * @param minRun only the methods with a run of consecutive calls of at least minRun are reported
+         * @return reports sorted by decreasing longest run
+         */
+        inline std::vector<ChattyCall> chattyCalls(std::size_t minRun = 2) {
+            std::vector<ChattyCall> reports;
+
+            MockVerifier::instance().forEachMock([&reports, minRun](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports, minRun](const std::string &key, const MethodCallVerifier &method) {
+                    ChattyCall chatty = method.chattyCalls(key);
+                    if (chatty.calls && chatty.maxRun >= minRun)
+                        reports.emplace_back(std::move(chatty));
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.maxRun > rhs.maxRun;
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Get the spy call report of all the spied methods called since the last cleanUp
+         *
+         * @return reports sorted by decreasing time spent into the original implementation
+         */
+        inline std::vector<SpyCall> spyCalls() {
+            std::vector<SpyCall> reports;
+
+            MockVerifier::instance().forEachMock([&reports](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports](const std::string &key, const MethodCallVerifier &method) {
+                    if (!method._spy.calls)
+                        return;
+                    reports.emplace_back(method._spy);
+                    reports.back().key = key;
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.total > rhs.total;
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Enable the transition analysis: the entry and exit of each mocked call are timestamped (steady clock)
+         *        and the time between the exit of a mocked call and the entry of the next one is attributed to the
+         *        (previous method, next method) transition. It gives a rough profile of the code under test between its
+         *        dependency calls.
+         */
+        inline void enableTransitions(bool enable = true) {
+            Settings::transitions = enable;
+        }
+
+        /**
+         * @brief Get the transition reports recorded since the last cleanUp
+         *
+         * @param minCalls only the transitions that happened at least minCalls times are reported
+         * @return reports sorted by decreasing total time
+         */
+        inline std::vector<Transition> transitions(std::size_t minCalls = 1) {
+            std::vector<Transition> reports = internal::TransitionTracker::transitions();
+
+            reports.erase(std::remove_if(reports.begin(), reports.end(), [minCalls](const auto &transition) {
+                return transition.calls < minCalls;
+            }), reports.end());
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.total > rhs.total;
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Get the transition report between two mocked methods
+         *
+         * @param from key (class name followed by the method name) of the method exited
+         * @param to key of the next method entered
+         * @return the transition report, empty if the transition never happened
+         */
+        inline Transition transition(const std::string &from, const std::string &to) {
+            for (auto &transition : internal::TransitionTracker::transitions()) {
+                if (transition.from == from && transition.to == to)
+                    return transition;
+            }
+            Transition result {};
+            result.from = from;
+            result.to = to;
+            return result;
+        }
+
+        /**
+         * @brief Check that the time spent between two mocked calls is in the given budget for every transitions
+         *
+         * @param budget maximum time accepted between two mocked calls
+         * @param percentile percentile of the transition histogram compared to the budget (1 for the maximum)
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if all the transitions are in the budget, false otherwise
+         */
+        inline bool verifyTransitions(std::chrono::nanoseconds budget, double percentile = 1., bool verbose = true) {
+            bool result = true;
+
+            for (const auto &transition : transitions()) {
+                std::chrono::nanoseconds elapsed = transition.percentile(percentile);
+                if (elapsed <= budget)
+                    continue;
+                result = false;
+                if (verbose) {
+                    std::string msg = "Verify transitions error between " + transition.from + " and " + transition.to +
+                            ", we expected at most " + std::to_string(budget.count()) + "ns but the percentile " +
+                            std::to_string(percentile) + " is " + std::to_string(elapsed.count()) + "ns (" +
+                            std::to_string(transition.calls) + " transitions)\n";
+                    Logging::Logger::report(transition.from + " -> " + transition.to, std::move(msg));
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Enable the argument sketch analysis: the arguments of each mocked call are added to streaming sketches in
+         *        fixed memory, per method (distinct argument tuples) and per parameter (distinct values, most frequent
+         *        values, and min / max / histogram for the arithmetic parameters). Without storing the call history, it
+         *        tells whether a cache in front of a dependency is worth it (repeated keys) and how big it should be
+         *        (distinct keys).
+         */
+        inline void enableSketches(bool enable = true) {
+            Settings::sketches = enable;
+        }
+
+        /**
+         * @brief Get the argument sketches of all the mocked methods called since the last cleanUp
+         *
+         * @return sketches sorted by decreasing number of calls
+         */
+        inline std::vector<ArgumentSketches> sketches() {
+            std::vector<ArgumentSketches> reports;
+
+            MockVerifier::instance().forEachMock([&reports](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports](const std::string &key, const MethodCallVerifier &method) {
+                    if (!method._sketches.calls)
+                        return;
+                    reports.emplace_back(method._sketches);
+                    reports.back().key = key;
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.calls > rhs.calls;
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Enable the cache simulation analysis: the argument tuple hash of each mocked call is recorded in call
+         *        order (8 bytes per call) to be replayed through simulated caches by MockClassVerifier::simulateCache
+         */
+        inline void enableCacheSimulation(bool enable = true) {
+            Settings::cacheSimulation = enable;
+        }
+
+        /**
+         * @brief Enable the payload analysis: the bytes passed in (arguments) and out (return value) of each mocked
+         *        method are counted, per method and into the alive FSeam::Scope, with a histogram of the bytes per
+         *        call. The size of a value is given by FSeam::PayloadSize.
+         */
+        inline void enablePayload(bool enable = true) {
+            Settings::payload = enable;
+        }
+
+        /**
+         * @brief Get the payload volume of all the mocked methods called since the last cleanUp
+         *
+         * @return payloads sorted by decreasing number of bytes (in + out)
+         */
+        inline std::vector<Payload> payloads() {
+            std::vector<Payload> reports;
+
+            MockVerifier::instance().forEachMock([&reports](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports](const std::string &key, const MethodCallVerifier &method) {
+                    if (!method._payload.calls)
+                        return;
+                    reports.emplace_back(method._payload);
+                    reports.back().key = key;
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.bytes() > rhs.bytes();
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Enable the concurrency analysis: the entry and exit of each mocked call are timestamped, to find how
+         *        many calls to a method have been in flight at the same time (see MockClassVerifier::verifyConcurrent)
+         */
+        inline void enableConcurrency(bool enable = true) {
+            Settings::concurrency = enable;
+        }
+
+        /**
+         * @brief Enable the call site analysis: each mocked call records its return address (__builtin_return_address),
+         *        aggregated per mocked method into a table of call sites. Cheaper than a stack trace, it tells which call
+         *        sites of the code under test are responsible for the calls to a dependency.
+         */
+        inline void enableCallSites(bool enable = true) {
+            Settings::callSites = enable;
+        }
+
+        /**
+         * @brief Get the call sites of the mocked methods called since the last cleanUp
+         *
+         * @param minCalls only the call sites from which at least minCalls calls have been done are reported
+         * @return reports sorted by decreasing number of calls
+         */
+        inline std::vector<CallSite> callSites(std::size_t minCalls = 1) {
+            std::vector<CallSite> reports;
+
+            MockVerifier::instance().forEachMock([&reports, minCalls](const MockClassVerifier &mock) {
+                mock.forEachMethod([&reports, minCalls](const std::string &key, const MethodCallVerifier &method) {
+                    for (const auto &[address, calls] : method._callSites) {
+                        if (calls < minCalls)
+                            continue;
+                        CallSite report {key, address, calls, std::string(), 0};
+                        Dl_info info {};
+                        if (dladdr(address, &info) && info.dli_fname) {
+                            auto base = reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+                            // addresses of a non position independent executable are absolute
+                            bool absolute = std::memcmp(info.dli_fbase, ELFMAG, SELFMAG) == 0 &&
+                                    reinterpret_cast<const ElfW(Ehdr) *>(info.dli_fbase)->e_type == ET_EXEC;
+                            report.module = info.dli_fname;
+                            report.offset = reinterpret_cast<std::uintptr_t>(address) - (absolute ? 0 : base);
+                        }
+                        reports.emplace_back(std::move(report));
+                    }
+                });
+            });
+            std::stable_sort(reports.begin(), reports.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.calls > rhs.calls;
+            });
+            return reports;
+        }
+
+        /**
+         * @brief Write the call sites into a tab separated file (calls, method key, module, offset), to be symbolized
+         *        offline with Generator/FSeamCallSites.py (addr2line)
+         *
+         * @return true if the file has been written, false otherwise
+         */
+        inline bool writeCallSites(const std::string &path, std::size_t minCalls = 1) {
+            std::ofstream file(path, std::ios::trunc);
+
+            for (const auto &callSite : callSites(minCalls))
+                file << callSite.calls << '\t' << callSite.key << '\t' << callSite.module << "\t0x" << std::hex << callSite.offset << std::dec << '\n';
+            return static_cast<bool>(file);
+        }
+
+        /**
+         * @brief Check that no mocked method has a duplicate call ratio higher than the given budget
+         *
+         * @param maxDuplicateRatio maximum ratio (between 0 and 1) of calls done with already seen arguments
+         * @param verbose flag if a debug string is required in case of false response (set to true by default)
+         * @return true if all the mocked methods are in the budget, false otherwise
+         */
+        inline bool verifyRedundantCalls(double maxDuplicateRatio, bool verbose = true) {
+            bool result = true;
+
+            for (const auto &redundant : redundantCalls()) {
+                if (redundant.duplicateRatio() <= maxDuplicateRatio)
+                    continue;
+                result = false;
+                if (verbose) {
+                    std::string msg = "Redundant calls for method " + redundant.key + ", " +
+                            std::to_string(redundant.calls - redundant.distinct) + " of the " + std::to_string(redundant.calls) +
+                            " calls reused already seen arguments, most repeated:\n";
+                    for (const auto &[args, count] : redundant.topTuples)
+                        msg += "  " + args + " x" + std::to_string(count) + "\n";
+                    Logging::Logger::report(redundant.key, std::move(msg));
+                }
+            }
+            return result;
+        }
+
     }
 
 }
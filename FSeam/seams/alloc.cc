@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * FSeam allocation seam
+ * Link seam of the global operator new / operator delete (all variants) and of the libc malloc family, counting each
+ * allocation into FSeam::AllocationScope before forwarding to the glibc allocator.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include <FSeam/FSeam.hpp>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+    void *counted(void *ptr, std::size_t size) noexcept {
+        if (ptr)
+            FSeam::AllocationScope::allocated(size, malloc_usable_size(ptr));
+        return ptr;
+    }
+
+    void release(void *ptr) noexcept {
+        if (!ptr)
+            return;
+        FSeam::AllocationScope::deallocated(malloc_usable_size(ptr));
+        __libc_free(ptr);
+    }
+
+    void *allocate(std::size_t size) {
+        if (void *ptr = counted(__libc_malloc(size ? size : 1), size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+    void *allocateAligned(std::size_t size, std::align_val_t alignment) {
+        if (void *ptr = counted(__libc_memalign(static_cast<std::size_t>(alignment), size ? size : 1), size))
+            return ptr;
+        throw std::bad_alloc();
+    }
+
+}
+
+extern "C" {
+
+void *malloc(size_t size) {
+    return counted(__libc_malloc(size), size);
+}
+
+void *calloc(size_t count, size_t size) {
+    return counted(__libc_calloc(count, size), count * size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    std::size_t previousSize = ptr ? malloc_usable_size(ptr) : 0;
+    void *reallocated = __libc_realloc(ptr, size);
+
+    if (!reallocated && size)
+        return nullptr; // ptr is left untouched
+    if (ptr)
+        FSeam::AllocationScope::deallocated(previousSize);
+    return counted(reallocated, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    return counted(__libc_memalign(alignment, size), size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    return counted(__libc_memalign(alignment, size), size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)))
+        return EINVAL;
+    *ptr = counted(__libc_memalign(alignment, size), size);
+    return *ptr ? 0 : ENOMEM;
+}
+
+void free(void *ptr) {
+    release(ptr);
+}
+
+}
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return counted(__libc_malloc(size ? size : 1), size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return counted(__libc_malloc(size ? size : 1), size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return counted(__libc_memalign(static_cast<std::size_t>(alignment), size ? size : 1), size);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return counted(__libc_memalign(static_cast<std::size_t>(alignment), size ? size : 1), size);
+}
+
+void operator delete(void *ptr) noexcept { release(ptr); }
+void operator delete[](void *ptr) noexcept { release(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { release(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { release(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { release(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { release(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { release(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { release(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { release(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { release(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { release(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { release(ptr); }
@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * FSeam clock seam
+ * Link seam of the libc time entry points used by std::chrono clocks and std::this_thread sleeps,
+ * backed by FSeam::Clock when enabled, forwarded to the libc implementation (found with dlsym) otherwise: the clock reads
+ * keep going through the vDSO when the virtual clock is disabled.
+ */
+
+#include <cstring>
+#include <ctime>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <FSeam/FSeam.hpp>
+
+namespace {
+
+    template <typename Function>
+    Function next(const char *name) {
+        static_assert(sizeof(Function) == sizeof(void *));
+        void *symbol = dlsym(RTLD_NEXT, name);
+        Function function;
+
+        if (!symbol) {
+            static const char message[] = "FSeam clock seam: libc implementation not found\n";
+            syscall(SYS_write, STDERR_FILENO, message, sizeof(message) - 1);
+            std::abort();
+        }
+        std::memcpy(&function, &symbol, sizeof(symbol));
+        return function;
+    }
+
+    using GetTimeFunction = int (*)(clockid_t, struct timespec *);
+    using SleepFunction = int (*)(const struct timespec *, struct timespec *);
+    using ClockSleepFunction = int (*)(clockid_t, int, const struct timespec *, struct timespec *);
+
+    GetTimeFunction realGetTime() { static GetTimeFunction function = next<GetTimeFunction>("clock_gettime"); return function; }
+    SleepFunction realSleep() { static SleepFunction function = next<SleepFunction>("nanosleep"); return function; }
+    ClockSleepFunction realClockSleep() { static ClockSleepFunction function = next<ClockSleepFunction>("clock_nanosleep"); return function; }
+
+    std::chrono::nanoseconds toDuration(const struct timespec *ts) {
+        return std::chrono::seconds(ts->tv_sec) + std::chrono::nanoseconds(ts->tv_nsec);
+    }
+
+    void fromDuration(std::chrono::nanoseconds duration, struct timespec *ts) {
+        ts->tv_sec = static_cast<time_t>(duration.count() / 1000000000);
+        ts->tv_nsec = static_cast<long>(duration.count() % 1000000000);
+    }
+
+    bool isVirtualClock(clockid_t clockId) {
+        return clockId == CLOCK_REALTIME || clockId == CLOCK_REALTIME_COARSE || clockId == CLOCK_MONOTONIC ||
+               clockId == CLOCK_MONOTONIC_RAW || clockId == CLOCK_MONOTONIC_COARSE || clockId == CLOCK_BOOTTIME;
+    }
+
+    std::chrono::nanoseconds virtualNow(clockid_t clockId) {
+        if (clockId == CLOCK_REALTIME || clockId == CLOCK_REALTIME_COARSE)
+            return FSeam::Clock::systemNow();
+        return FSeam::Clock::steadyNow();
+    }
+
+}
+
+extern "C" {
+
+int clock_gettime(clockid_t clockId, struct timespec *tp) __THROW {
+    FSeam::SyscallScope::count(FSeam::Syscall::CLOCK_GETTIME);
+    if (!FSeam::Clock::isEnabled() || !isVirtualClock(clockId))
+        return realGetTime()(clockId, tp);
+    fromDuration(virtualNow(clockId), tp);
+    return 0;
+}
+
+int nanosleep(const struct timespec *requested, struct timespec *remaining) {
+    if (!FSeam::Clock::isEnabled() || !requested)
+        return realSleep()(requested, remaining);
+    FSeam::Clock::advance(toDuration(requested));
+    if (remaining)
+        fromDuration(std::chrono::nanoseconds(0), remaining);
+    return 0;
+}
+
+int clock_nanosleep(clockid_t clockId, int flags, const struct timespec *requested, struct timespec *remaining) {
+    if (!FSeam::Clock::isEnabled() || !requested || !isVirtualClock(clockId))
+        return realClockSleep()(clockId, flags, requested, remaining);
+    if (flags & TIMER_ABSTIME)
+        FSeam::Clock::advance(toDuration(requested) - virtualNow(clockId));
+    else
+        FSeam::Clock::advance(toDuration(requested));
+    if (remaining && !(flags & TIMER_ABSTIME))
+        fromDuration(std::chrono::nanoseconds(0), remaining);
+    return 0;
+}
+
+}
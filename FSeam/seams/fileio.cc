@@ -0,0 +1,278 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * FSeam file I/O seam
+ * Link seam of the libc POSIX file entry points (open, read, write, pread, pwrite, lseek, fsync, fdatasync, close),
+ * backed by FSeam::MemoryFs for the paths under its root when enabled, forwarded to the kernel otherwise.
+ * The read / write and sync calls are counted into FSeam::SyscallScope (see the syscall seam).
+ */
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <FSeam/FSeam.hpp>
+
+namespace {
+
+    struct OpenFile {
+        std::string path;
+        std::shared_ptr<std::string> content;
+        off_t offset = 0;
+        int flags = 0;
+    };
+
+    // descriptors opened by the seam, each one reserves a real descriptor (on /dev/null) to never collide with the kernel ones
+    std::map<int, OpenFile> &openFiles() {
+        static std::map<int, OpenFile> files;
+        return files;
+    }
+
+    // set while the seam is calling into FSeam, the I/O done by FSeam itself (logging) is then forwarded to the kernel
+    thread_local bool inSeam = false;
+
+    bool isManagedFd(int fd) {
+        if (inSeam || !FSeam::MemoryFs::isEnabled())
+            return false;
+        std::lock_guard<std::mutex> lock(FSeam::MemoryFs::internal::mutex);
+        return openFiles().find(fd) != openFiles().end();
+    }
+
+    /**
+     * Register the syscall on the mock of the file and on the mock of the whole file system, the operation is executed
+     * between the duped handlers (latency, error injection) and the call registration, under the MemoryFs lock
+     */
+    template <typename Operation>
+    ssize_t mockedCall(const std::string &methodName, FSeam::MemoryFs::Data data, Operation &&operation) {
+        inSeam = true;
+        auto fileMock = FSeam::MemoryFs::file(data.path);
+        auto allMock = FSeam::MemoryFs::all();
+        fileMock->invokeDupedMethod(methodName, &data);
+        allMock->invokeDupedMethod(methodName, &data);
+        inSeam = false;
+
+        ssize_t result = -1;
+        int error = data.error;
+        if (!error) {
+            std::lock_guard<std::mutex> lock(FSeam::MemoryFs::internal::mutex);
+            result = operation(error, data);
+        }
+
+        inSeam = true;
+        fileMock->methodCall(methodName, &data);
+        allMock->methodCall(methodName, &data);
+        inSeam = false;
+        if (error) {
+            errno = error;
+            return -1;
+        }
+        return result;
+    }
+
+    FSeam::MemoryFs::Data fdData(int fd, std::size_t bytes = 0) {
+        std::lock_guard<std::mutex> lock(FSeam::MemoryFs::internal::mutex);
+        return FSeam::MemoryFs::Data{openFiles().at(fd).path, fd, bytes};
+    }
+
+    int openMemory(const char *path, int flags) {
+        FSeam::MemoryFs::Data data{path};
+
+        return static_cast<int>(mockedCall(FSeam::MemoryFile::open::NAME, data, [&](int &error, FSeam::MemoryFs::Data &) -> ssize_t {
+            auto &files = FSeam::MemoryFs::internal::files;
+            auto it = files.find(path);
+
+            if (it == files.end() && !(flags & O_CREAT)) {
+                error = ENOENT;
+                return -1;
+            }
+            if (it != files.end() && (flags & O_CREAT) && (flags & O_EXCL)) {
+                error = EEXIST;
+                return -1;
+            }
+            if (it == files.end())
+                it = files.emplace(path, std::make_shared<std::string>()).first;
+            else if ((flags & O_TRUNC) && (flags & O_ACCMODE) != O_RDONLY)
+                it->second->clear();
+
+            int fd = static_cast<int>(syscall(SYS_openat, AT_FDCWD, "/dev/null", O_RDONLY | O_CLOEXEC));
+            if (fd < 0) {
+                error = errno;
+                return -1;
+            }
+            openFiles()[fd] = OpenFile{path, it->second, 0, flags};
+            return fd;
+        }));
+    }
+
+    ssize_t transfer(const std::string &methodName, int fd, void *readBuffer, const void *writeBuffer, std::size_t count,
+                     std::optional<off_t> position) {
+        return mockedCall(methodName, fdData(fd, count), [&](int &error, FSeam::MemoryFs::Data &data) -> ssize_t {
+            OpenFile &file = openFiles().at(fd);
+            int accessMode = file.flags & O_ACCMODE;
+
+            if ((readBuffer && accessMode == O_WRONLY) || (writeBuffer && accessMode == O_RDONLY)) {
+                error = EBADF;
+                return -1;
+            }
+            if (position && *position < 0) {
+                error = EINVAL;
+                return -1;
+            }
+            std::string &content = *file.content;
+            std::size_t offset = static_cast<std::size_t>(position.value_or(file.offset));
+
+            if (writeBuffer) {
+                if (!position && (file.flags & O_APPEND))
+                    offset = content.size();
+                if (content.size() < offset + count)
+                    content.resize(offset + count, '\0');
+                content.replace(offset, count, static_cast<const char *>(writeBuffer), count);
+            }
+            else {
+                count = offset < content.size() ? std::min(count, content.size() - offset) : 0;
+                std::memcpy(readBuffer, content.data() + offset, count);
+            }
+            if (!position)
+                file.offset = static_cast<off_t>(offset + count);
+            data.bytes = count;
+            return static_cast<ssize_t>(count);
+        });
+    }
+
+    int syncMemory(const std::string &methodName, int fd) {
+        return static_cast<int>(mockedCall(methodName, fdData(fd), [](int &, FSeam::MemoryFs::Data &) -> ssize_t { return 0; }));
+    }
+
+}
+
+extern "C" {
+
+int open(const char *path, int flags, ...) {
+    mode_t mode = 0;
+
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+    if (inSeam || !FSeam::MemoryFs::isManaged(path))
+        return static_cast<int>(syscall(SYS_openat, AT_FDCWD, path, flags, mode));
+    return openMemory(path, flags);
+}
+
+int open64(const char *path, int flags, ...) {
+    mode_t mode = 0;
+
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list args;
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+    return open(path, flags, mode);
+}
+
+ssize_t read(int fd, void *buffer, size_t count) {
+    ssize_t result = isManagedFd(fd) ? transfer(FSeam::MemoryFile::read::NAME, fd, buffer, nullptr, count, std::nullopt)
+                                     : syscall(SYS_read, fd, buffer, count);
+    FSeam::SyscallScope::count(FSeam::Syscall::READ, result);
+    return result;
+}
+
+ssize_t write(int fd, const void *buffer, size_t count) {
+    ssize_t result = isManagedFd(fd) ? transfer(FSeam::MemoryFile::write::NAME, fd, nullptr, buffer, count, std::nullopt)
+                                     : syscall(SYS_write, fd, buffer, count);
+    FSeam::SyscallScope::count(FSeam::Syscall::WRITE, result);
+    return result;
+}
+
+ssize_t pread(int fd, void *buffer, size_t count, off_t offset) {
+    ssize_t result = isManagedFd(fd) ? transfer(FSeam::MemoryFile::pread::NAME, fd, buffer, nullptr, count, offset)
+                                     : syscall(SYS_pread64, fd, buffer, count, offset);
+    FSeam::SyscallScope::count(FSeam::Syscall::PREAD, result);
+    return result;
+}
+
+ssize_t pread64(int fd, void *buffer, size_t count, off64_t offset) {
+    return pread(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+ssize_t pwrite(int fd, const void *buffer, size_t count, off_t offset) {
+    ssize_t result = isManagedFd(fd) ? transfer(FSeam::MemoryFile::pwrite::NAME, fd, nullptr, buffer, count, offset)
+                                     : syscall(SYS_pwrite64, fd, buffer, count, offset);
+    FSeam::SyscallScope::count(FSeam::Syscall::PWRITE, result);
+    return result;
+}
+
+ssize_t pwrite64(int fd, const void *buffer, size_t count, off64_t offset) {
+    return pwrite(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+off_t lseek(int fd, off_t offset, int whence) __THROW {
+    if (!isManagedFd(fd))
+        return static_cast<off_t>(syscall(SYS_lseek, fd, offset, whence));
+    return static_cast<off_t>(mockedCall(FSeam::MemoryFile::lseek::NAME, fdData(fd), [&](int &error, FSeam::MemoryFs::Data &) -> ssize_t {
+        OpenFile &file = openFiles().at(fd);
+        off_t base = whence == SEEK_SET ? 0 : whence == SEEK_CUR ? file.offset : static_cast<off_t>(file.content->size());
+
+        if ((whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END) || base + offset < 0) {
+            error = EINVAL;
+            return -1;
+        }
+        file.offset = base + offset;
+        return file.offset;
+    }));
+}
+
+off64_t lseek64(int fd, off64_t offset, int whence) __THROW {
+    return lseek(fd, static_cast<off_t>(offset), whence);
+}
+
+int fsync(int fd) {
+    FSeam::SyscallScope::count(FSeam::Syscall::FSYNC);
+    if (!isManagedFd(fd))
+        return static_cast<int>(syscall(SYS_fsync, fd));
+    return syncMemory(FSeam::MemoryFile::fsync::NAME, fd);
+}
+
+int fdatasync(int fd) {
+    FSeam::SyscallScope::count(FSeam::Syscall::FDATASYNC);
+    if (!isManagedFd(fd))
+        return static_cast<int>(syscall(SYS_fdatasync, fd));
+    return syncMemory(FSeam::MemoryFile::fdatasync::NAME, fd);
+}
+
+int close(int fd) {
+    if (!isManagedFd(fd))
+        return static_cast<int>(syscall(SYS_close, fd));
+    return static_cast<int>(mockedCall(FSeam::MemoryFile::close::NAME, fdData(fd), [fd](int &, FSeam::MemoryFs::Data &) -> ssize_t {
+        openFiles().erase(fd);
+        return syscall(SYS_close, fd);
+    }));
+}
+
+}
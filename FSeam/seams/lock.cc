@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * FSeam lock seam
+ * Link seam of the pthread mutex and condition variable entry points (pthread_mutex_lock, pthread_mutex_trylock,
+ * pthread_mutex_unlock, pthread_cond_wait, pthread_cond_timedwait, pthread_cond_clockwait, pthread_cond_signal, pthread_cond_broadcast), counting
+ * into FSeam::LockScope while a scope is alive before forwarding to the libc implementation (found with dlsym).
+ */
+
+#include <cstring>
+#include <ctime>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <FSeam/FSeam.hpp>
+
+namespace {
+
+    template <typename Function>
+    Function next(const char *name) {
+        static_assert(sizeof(Function) == sizeof(void *));
+        void *symbol = dlsym(RTLD_NEXT, name);
+        Function function;
+
+        if (!symbol) {
+            static const char message[] = "FSeam lock seam: libc implementation not found\n";
+            syscall(SYS_write, STDERR_FILENO, message, sizeof(message) - 1);
+            std::abort();
+        }
+        std::memcpy(&function, &symbol, sizeof(symbol));
+        return function;
+    }
+
+    using MutexFunction = int (*)(pthread_mutex_t *);
+    using WaitFunction = int (*)(pthread_cond_t *, pthread_mutex_t *);
+    using TimedWaitFunction = int (*)(pthread_cond_t *, pthread_mutex_t *, const struct timespec *);
+    using ClockWaitFunction = int (*)(pthread_cond_t *, pthread_mutex_t *, clockid_t, const struct timespec *);
+    using ConditionFunction = int (*)(pthread_cond_t *);
+    using GetTimeFunction = int (*)(clockid_t, struct timespec *);
+
+    // resolved on first use (the libc implementations don't lock while dlsym is resolving them)
+    MutexFunction realLock() { static MutexFunction function = next<MutexFunction>("pthread_mutex_lock"); return function; }
+    MutexFunction realTryLock() { static MutexFunction function = next<MutexFunction>("pthread_mutex_trylock"); return function; }
+    MutexFunction realUnlock() { static MutexFunction function = next<MutexFunction>("pthread_mutex_unlock"); return function; }
+    WaitFunction realWait() { static WaitFunction function = next<WaitFunction>("pthread_cond_wait"); return function; }
+    TimedWaitFunction realTimedWait() { static TimedWaitFunction function = next<TimedWaitFunction>("pthread_cond_timedwait"); return function; }
+    ClockWaitFunction realClockWait() { static ClockWaitFunction function = next<ClockWaitFunction>("pthread_cond_clockwait"); return function; }
+    ConditionFunction realSignal() { static ConditionFunction function = next<ConditionFunction>("pthread_cond_signal"); return function; }
+    ConditionFunction realBroadcast() { static ConditionFunction function = next<ConditionFunction>("pthread_cond_broadcast"); return function; }
+    GetTimeFunction realGetTime() { static GetTimeFunction function = next<GetTimeFunction>("clock_gettime"); return function; }
+
+    // real monotonic time (libc implementation, so the vDSO), neither virtualized by the clock seam nor counted by the
+    // syscall seam
+    std::chrono::nanoseconds now() {
+        struct timespec ts {};
+        realGetTime()(CLOCK_MONOTONIC, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    }
+
+    template <typename Wait>
+    int countedWait(pthread_cond_t *condition, pthread_mutex_t *mutex, Wait &&wait) {
+        if (!FSeam::LockScope::isActive())
+            return wait();
+        FSeam::LockScope::waited(condition);
+        FSeam::LockScope::released(mutex, now());
+        int result = wait();
+        FSeam::LockScope::acquired(mutex, false, now());
+        return result;
+    }
+
+}
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t *mutex) __THROWNL {
+    if (!FSeam::LockScope::isActive())
+        return realLock()(mutex);
+    // an acquisition is contended when it can't be done without waiting
+    bool contended = realTryLock()(mutex) == EBUSY;
+    int result = contended ? realLock()(mutex) : 0;
+
+    if (result == 0)
+        FSeam::LockScope::acquired(mutex, contended, now());
+    return result;
+}
+
+int pthread_mutex_trylock(pthread_mutex_t *mutex) __THROWNL {
+    int result = realTryLock()(mutex);
+
+    if (result == 0 && FSeam::LockScope::isActive())
+        FSeam::LockScope::acquired(mutex, false, now());
+    return result;
+}
+
+int pthread_mutex_unlock(pthread_mutex_t *mutex) __THROWNL {
+    if (FSeam::LockScope::isActive())
+        FSeam::LockScope::released(mutex, now());
+    return realUnlock()(mutex);
+}
+
+int pthread_cond_wait(pthread_cond_t *condition, pthread_mutex_t *mutex) {
+    return countedWait(condition, mutex, [&]() { return realWait()(condition, mutex); });
+}
+
+int pthread_cond_timedwait(pthread_cond_t *condition, pthread_mutex_t *mutex, const struct timespec *time) {
+    return countedWait(condition, mutex, [&]() { return realTimedWait()(condition, mutex, time); });
+}
+
+int pthread_cond_clockwait(pthread_cond_t *condition, pthread_mutex_t *mutex, clockid_t clockId, const struct timespec *time) {
+    return countedWait(condition, mutex, [&]() { return realClockWait()(condition, mutex, clockId, time); });
+}
+
+int pthread_cond_signal(pthread_cond_t *condition) __THROWNL {
+    if (FSeam::LockScope::isActive())
+        FSeam::LockScope::signaled(condition);
+    return realSignal()(condition);
+}
+
+int pthread_cond_broadcast(pthread_cond_t *condition) __THROWNL {
+    if (FSeam::LockScope::isActive())
+        FSeam::LockScope::signaled(condition);
+    return realBroadcast()(condition);
+}
+
+}
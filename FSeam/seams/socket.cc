@@ -0,0 +1,449 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * FSeam socket seam
+ * Link seam of the libc socket entry points (socket, connect, send, sendto, recv, recvfrom, setsockopt, epoll_ctl,
+ * epoll_wait, epoll_pwait), backed by the FSeam::Network stand-in servers when enabled, forwarded to the kernel otherwise.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <FSeam/FSeam.hpp>
+
+namespace {
+
+    struct Datagram {
+        std::string address;
+        std::string payload;
+    };
+
+    /**
+     * Socket served by the stand-in, it reserves a real descriptor (an AF_UNIX socket): the descriptor is never
+     * intercepted on close, a socket is dropped as soon as its descriptor doesn't refer to the reserved one anymore
+     */
+    struct SocketState {
+        dev_t device = 0;
+        ino_t inode = 0;
+        int type = SOCK_STREAM;
+        std::string address;               // connected address
+        std::string stream;                // bytes to receive (SOCK_STREAM)
+        std::deque<Datagram> datagrams;    // messages to receive (SOCK_DGRAM)
+    };
+
+    std::map<int, SocketState> &sockets() {
+        static std::map<int, SocketState> states;
+        return states;
+    }
+
+    // epoll descriptor -> interests on the stand-in sockets (never registered into the kernel epoll instance)
+    std::map<int, std::map<int, struct epoll_event> > &interests() {
+        static std::map<int, std::map<int, struct epoll_event> > registered;
+        return registered;
+    }
+
+    // set while the seam is calling into FSeam, the I/O done by FSeam itself (logging) is then forwarded to the kernel
+    thread_local bool inSeam = false;
+
+    // must be called with the Network lock
+    SocketState *findSocket(int fd) {
+        auto it = sockets().find(fd);
+        struct stat status {};
+
+        if (it == sockets().end())
+            return nullptr;
+        if (fstat(fd, &status) != 0 || status.st_dev != it->second.device || status.st_ino != it->second.inode) {
+            sockets().erase(it);
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    bool isManagedFd(int fd) {
+        if (inSeam || !FSeam::Network::isEnabled())
+            return false;
+        std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+        return findSocket(fd) != nullptr;
+    }
+
+    std::string toAddress(const struct sockaddr *address) {
+        char ip[INET6_ADDRSTRLEN] = {};
+
+        if (address && address->sa_family == AF_INET) {
+            auto in = reinterpret_cast<const struct sockaddr_in *>(address);
+            inet_ntop(AF_INET, &in->sin_addr, ip, sizeof(ip));
+            return std::string(ip) + ":" + std::to_string(ntohs(in->sin_port));
+        }
+        if (address && address->sa_family == AF_INET6) {
+            auto in6 = reinterpret_cast<const struct sockaddr_in6 *>(address);
+            inet_ntop(AF_INET6, &in6->sin6_addr, ip, sizeof(ip));
+            return "[" + std::string(ip) + "]:" + std::to_string(ntohs(in6->sin6_port));
+        }
+        return "";
+    }
+
+    void fromAddress(const std::string &address, struct sockaddr *output, socklen_t *length) {
+        struct sockaddr_storage storage {};
+        socklen_t size = 0;
+        std::size_t separator = address.rfind(':');
+        std::string ip = address.substr(0, separator);
+        auto port = htons(static_cast<std::uint16_t>(std::stoi(address.substr(separator + 1))));
+
+        if (!ip.empty() && ip.front() == '[') {
+            auto in6 = reinterpret_cast<struct sockaddr_in6 *>(&storage);
+            in6->sin6_family = AF_INET6;
+            in6->sin6_port = port;
+            inet_pton(AF_INET6, ip.substr(1, ip.size() - 2).c_str(), &in6->sin6_addr);
+            size = sizeof(struct sockaddr_in6);
+        }
+        else {
+            auto in = reinterpret_cast<struct sockaddr_in *>(&storage);
+            in->sin_family = AF_INET;
+            in->sin_port = port;
+            inet_pton(AF_INET, ip.c_str(), &in->sin_addr);
+            size = sizeof(struct sockaddr_in);
+        }
+        std::memcpy(output, &storage, std::min(size, *length));
+        *length = size;
+    }
+
+    std::shared_ptr<FSeam::Network::internal::Server> findServer(const std::string &address) {
+        std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+        auto it = FSeam::Network::internal::servers.find(address);
+
+        return it == FSeam::Network::internal::servers.end() ? nullptr : it->second;
+    }
+
+    /**
+     * Register the call on the mock of the stand-in (if the address is known) and on the mock of the whole network, the
+     * operation is executed between the duped handlers (latency, error injection) and the call registration
+     */
+    template <typename Operation>
+    ssize_t mockedCall(const std::string &methodName, FSeam::Network::Data data, Operation &&operation) {
+        inSeam = true;
+        std::shared_ptr<FSeam::MockClassVerifier> serverMock;
+        if (!data.address.empty())
+            serverMock = FSeam::Network::server(data.address);
+        auto allMock = FSeam::Network::all();
+        if (serverMock)
+            serverMock->invokeDupedMethod(methodName, &data);
+        allMock->invokeDupedMethod(methodName, &data);
+        inSeam = false;
+
+        ssize_t result = -1;
+        int error = data.error;
+        if (!error)
+            result = operation(error, data);
+
+        inSeam = true;
+        if (serverMock)
+            serverMock->methodCall(methodName, &data);
+        allMock->methodCall(methodName, &data);
+        inSeam = false;
+        if (error) {
+            errno = error;
+            return -1;
+        }
+        return result;
+    }
+
+    ssize_t sendMessage(int fd, const void *buffer, std::size_t length, const struct sockaddr *destination) {
+        std::string address;
+        int type;
+        {
+            std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+            SocketState *state = findSocket(fd);
+            if (!state) {
+                errno = EBADF;
+                return -1;
+            }
+            address = destination ? toAddress(destination) : state->address;
+            type = state->type;
+        }
+
+        return mockedCall(FSeam::Socket::send::NAME, FSeam::Network::Data{address, fd, length},
+                          [&](int &error, FSeam::Network::Data &data) -> ssize_t {
+            if (address.empty()) {
+                error = type == SOCK_STREAM ? ENOTCONN : EDESTADDRREQ;
+                return -1;
+            }
+            auto server = findServer(address);
+            if (!server) {
+                error = ECONNREFUSED;
+                return -1;
+            }
+
+            std::chrono::nanoseconds delay {0};
+            if (server->link.latency)
+                delay += FSeam::Latency::sample(*server->link.latency);
+            if (server->link.bandwidth)
+                delay += std::chrono::nanoseconds(static_cast<std::int64_t>(length * 1000000000ull / server->link.bandwidth));
+            if (delay.count() > 0) {
+                inSeam = true;
+                FSeam::Latency::delay(delay);
+                inSeam = false;
+            }
+            std::string response = server->handler(std::string_view(static_cast<const char *>(buffer), length));
+
+            std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+            server->traffic.sent += length;
+            if (SocketState *state = findSocket(fd); state) {
+                if (type == SOCK_STREAM)
+                    state->stream += response;
+                else if (!response.empty())
+                    state->datagrams.push_back(Datagram{address, std::move(response)});
+            }
+            data.bytes = length;
+            return static_cast<ssize_t>(length);
+        });
+    }
+
+    ssize_t receiveMessage(int fd, void *buffer, std::size_t length, int flags, struct sockaddr *source, socklen_t *sourceLength) {
+        std::string address;
+        {
+            std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+            SocketState *state = findSocket(fd);
+            if (!state) {
+                errno = EBADF;
+                return -1;
+            }
+            address = state->type == SOCK_DGRAM && !state->datagrams.empty() ? state->datagrams.front().address : state->address;
+        }
+        auto server = findServer(address);
+
+        return mockedCall(FSeam::Socket::recv::NAME, FSeam::Network::Data{address, fd, length},
+                          [&](int &error, FSeam::Network::Data &data) -> ssize_t {
+            std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+            SocketState *state = findSocket(fd);
+            std::size_t received = 0;
+
+            if (!state) {
+                error = EBADF;
+                return -1;
+            }
+            if (state->type == SOCK_STREAM ? state->stream.empty() : state->datagrams.empty()) {
+                // the stand-in answers synchronously on send, nothing will ever be received: a non blocking socket would
+                // block, a blocking one sees the end of the stream (instead of blocking forever)
+                if ((flags & MSG_DONTWAIT) || (syscall(SYS_fcntl, fd, F_GETFL) & O_NONBLOCK)) {
+                    error = EAGAIN;
+                    return -1;
+                }
+                data.bytes = 0;
+                return 0;
+            }
+            if (state->type == SOCK_STREAM) {
+                received = std::min(length, state->stream.size());
+                if (server && server->link.segmentSize)
+                    received = std::min(received, server->link.segmentSize);
+                std::memcpy(buffer, state->stream.data(), received);
+                if (!(flags & MSG_PEEK))
+                    state->stream.erase(0, received);
+            }
+            else {
+                const Datagram &datagram = state->datagrams.front();
+                received = std::min(length, datagram.payload.size());
+                std::memcpy(buffer, datagram.payload.data(), received);
+                if (source && sourceLength)
+                    fromAddress(datagram.address, source, sourceLength);
+                if (!(flags & MSG_PEEK))
+                    state->datagrams.pop_front();
+            }
+            if (server)
+                server->traffic.received += received;
+            data.bytes = received;
+            return static_cast<ssize_t>(received);
+        });
+    }
+
+    int waitEvents(int epfd, struct epoll_event *events, int maxEvents, int timeout, const sigset_t *sigmask) {
+        FSeam::SyscallScope::count(FSeam::Syscall::EPOLL_WAIT);
+        if (inSeam || !FSeam::Network::isEnabled() || maxEvents <= 0)
+            return static_cast<int>(syscall(SYS_epoll_pwait, epfd, events, maxEvents, timeout, sigmask, _NSIG / 8));
+        {
+            std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+            if (interests().find(epfd) == interests().end())
+                return static_cast<int>(syscall(SYS_epoll_pwait, epfd, events, maxEvents, timeout, sigmask, _NSIG / 8));
+        }
+
+        return static_cast<int>(mockedCall(FSeam::Socket::epoll_wait::NAME, FSeam::Network::Data{"", epfd},
+                                           [&](int &error, FSeam::Network::Data &) -> ssize_t {
+            int ready = 0;
+            {
+                std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+                auto &registered = interests()[epfd];
+
+                for (auto it = registered.begin(); it != registered.end() && ready < maxEvents;) {
+                    SocketState *state = findSocket(it->first);
+                    if (!state) {
+                        it = registered.erase(it);
+                        continue;
+                    }
+                    bool readable = state->type == SOCK_STREAM ? !state->stream.empty() : !state->datagrams.empty();
+                    bool writable = state->type == SOCK_DGRAM || !state->address.empty();
+                    std::uint32_t mask = (readable ? EPOLLIN : 0u) | (writable ? EPOLLOUT : 0u);
+
+                    if (mask & it->second.events) {
+                        events[ready].events = mask & it->second.events;
+                        events[ready].data = it->second.data;
+                        ++ready;
+                    }
+                    ++it;
+                }
+            }
+            if (ready == maxEvents)
+                return ready;
+            // kernel descriptors registered on the same epoll instance
+            int kernelReady = static_cast<int>(syscall(SYS_epoll_pwait, epfd, events + ready, maxEvents - ready,
+                                                       ready ? 0 : timeout, sigmask, _NSIG / 8));
+            if (kernelReady < 0 && !ready) {
+                error = errno;
+                return -1;
+            }
+            return ready + std::max(kernelReady, 0);
+        }));
+    }
+
+}
+
+extern "C" {
+
+int socket(int domain, int type, int protocol) __THROW {
+    if (inSeam || !FSeam::Network::isEnabled() || (domain != AF_INET && domain != AF_INET6))
+        return static_cast<int>(syscall(SYS_socket, domain, type, protocol));
+
+    return static_cast<int>(mockedCall(FSeam::Socket::socket::NAME, FSeam::Network::Data{}, [&](int &error, FSeam::Network::Data &) -> ssize_t {
+        int fd = static_cast<int>(syscall(SYS_socket, AF_UNIX, SOCK_STREAM | (type & (SOCK_NONBLOCK | SOCK_CLOEXEC)), 0));
+        struct stat status {};
+
+        if (fd < 0 || fstat(fd, &status) != 0) {
+            error = errno;
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+        SocketState &state = sockets()[fd];
+        state = SocketState {};
+        state.device = status.st_dev;
+        state.inode = status.st_ino;
+        state.type = type & ~(SOCK_NONBLOCK | SOCK_CLOEXEC);
+        return fd;
+    }));
+}
+
+int connect(int fd, const struct sockaddr *address, socklen_t length) {
+    if (!isManagedFd(fd))
+        return static_cast<int>(syscall(SYS_connect, fd, address, length));
+    std::string connected = toAddress(address);
+
+    return static_cast<int>(mockedCall(FSeam::Socket::connect::NAME, FSeam::Network::Data{connected, fd},
+                                       [&](int &error, FSeam::Network::Data &) -> ssize_t {
+        auto server = findServer(connected);
+        std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+        SocketState *state = findSocket(fd);
+
+        if (!server || !state) {
+            error = ECONNREFUSED;
+            return -1;
+        }
+        state->address = connected;
+        if (state->type == SOCK_STREAM)
+            ++server->traffic.connections;
+        return 0;
+    }));
+}
+
+ssize_t send(int fd, const void *buffer, size_t length, int flags) {
+    if (!isManagedFd(fd))
+        return syscall(SYS_sendto, fd, buffer, length, flags, nullptr, 0);
+    return sendMessage(fd, buffer, length, nullptr);
+}
+
+ssize_t sendto(int fd, const void *buffer, size_t length, int flags, const struct sockaddr *address, socklen_t addressLength) {
+    if (!isManagedFd(fd))
+        return syscall(SYS_sendto, fd, buffer, length, flags, address, addressLength);
+    return sendMessage(fd, buffer, length, address);
+}
+
+ssize_t recv(int fd, void *buffer, size_t length, int flags) {
+    if (!isManagedFd(fd))
+        return syscall(SYS_recvfrom, fd, buffer, length, flags, nullptr, nullptr);
+    return receiveMessage(fd, buffer, length, flags, nullptr, nullptr);
+}
+
+ssize_t recvfrom(int fd, void *buffer, size_t length, int flags, struct sockaddr *address, socklen_t *addressLength) {
+    if (!isManagedFd(fd))
+        return syscall(SYS_recvfrom, fd, buffer, length, flags, address, addressLength);
+    return receiveMessage(fd, buffer, length, flags, address, addressLength);
+}
+
+int setsockopt(int fd, int level, int name, const void *value, socklen_t length) __THROW {
+    // protocol options (TCP_NODELAY...) don't apply to the reserved AF_UNIX socket, they are accepted and ignored
+    if (!isManagedFd(fd) || level == SOL_SOCKET)
+        return static_cast<int>(syscall(SYS_setsockopt, fd, level, name, value, length));
+    return 0;
+}
+
+int epoll_ctl(int epfd, int operation, int fd, struct epoll_event *event) __THROW {
+    if (!isManagedFd(fd))
+        return static_cast<int>(syscall(SYS_epoll_ctl, epfd, operation, fd, event));
+
+    return static_cast<int>(mockedCall(FSeam::Socket::epoll_ctl::NAME, FSeam::Network::Data{"", fd},
+                                       [&](int &error, FSeam::Network::Data &) -> ssize_t {
+        std::lock_guard<std::mutex> lock(FSeam::Network::internal::mutex);
+        auto &registered = interests()[epfd];
+        bool exists = registered.find(fd) != registered.end();
+
+        if ((operation == EPOLL_CTL_ADD && exists) || (operation != EPOLL_CTL_ADD && !exists)) {
+            error = exists ? EEXIST : ENOENT;
+            return -1;
+        }
+        if (operation == EPOLL_CTL_DEL)
+            registered.erase(fd);
+        else if (!event) {
+            error = EFAULT;
+            return -1;
+        }
+        else
+            registered[fd] = *event;
+        return 0;
+    }));
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxEvents, int timeout) {
+    return waitEvents(epfd, events, maxEvents, timeout, nullptr);
+}
+
+int epoll_pwait(int epfd, struct epoll_event *events, int maxEvents, int timeout, const sigset_t *sigmask) {
+    return waitEvents(epfd, events, maxEvents, timeout, sigmask);
+}
+
+}
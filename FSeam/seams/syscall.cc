@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2019 Quentin Balland
+// Project : https://github.com/FreeYourSoul/FSeam
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * FSeam syscall seam
+ * Counting pass-through of the libc entry points of common syscalls (read, write, pread, pwrite, fsync, fdatasync, mmap,
+ * clock_gettime, epoll_wait, epoll_pwait): each call is counted into FSeam::SyscallScope and forwarded to the kernel
+ * (clock_gettime is forwarded to the libc implementation, found with dlsym, in order to keep the vDSO).
+ * The definitions are weak, the file I/O, clock and socket seams override them (and count the same way) when linked
+ * into the same test.
+ */
+
+#include <ctime>
+#include <csignal>
+#include <cstring>
+#include <dlfcn.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <FSeam/FSeam.hpp>
+
+#define FSEAM_WEAK __attribute__((weak))
+
+namespace {
+
+    using GetTimeFunction = int (*)(clockid_t, struct timespec *);
+
+    GetTimeFunction realGetTime() {
+        static GetTimeFunction function = [] {
+            void *symbol = dlsym(RTLD_NEXT, "clock_gettime");
+            GetTimeFunction resolved;
+
+            if (!symbol) {
+                static const char message[] = "FSeam syscall seam: libc implementation not found\n";
+                syscall(SYS_write, STDERR_FILENO, message, sizeof(message) - 1);
+                std::abort();
+            }
+            std::memcpy(&resolved, &symbol, sizeof(symbol));
+            return resolved;
+        }();
+        return function;
+    }
+
+}
+
+extern "C" {
+
+FSEAM_WEAK ssize_t read(int fd, void *buffer, size_t count) {
+    ssize_t result = syscall(SYS_read, fd, buffer, count);
+    FSeam::SyscallScope::count(FSeam::Syscall::READ, result);
+    return result;
+}
+
+FSEAM_WEAK ssize_t write(int fd, const void *buffer, size_t count) {
+    ssize_t result = syscall(SYS_write, fd, buffer, count);
+    FSeam::SyscallScope::count(FSeam::Syscall::WRITE, result);
+    return result;
+}
+
+FSEAM_WEAK ssize_t pread(int fd, void *buffer, size_t count, off_t offset) {
+    ssize_t result = syscall(SYS_pread64, fd, buffer, count, offset);
+    FSeam::SyscallScope::count(FSeam::Syscall::PREAD, result);
+    return result;
+}
+
+FSEAM_WEAK ssize_t pread64(int fd, void *buffer, size_t count, off64_t offset) {
+    return pread(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+FSEAM_WEAK ssize_t pwrite(int fd, const void *buffer, size_t count, off_t offset) {
+    ssize_t result = syscall(SYS_pwrite64, fd, buffer, count, offset);
+    FSeam::SyscallScope::count(FSeam::Syscall::PWRITE, result);
+    return result;
+}
+
+FSEAM_WEAK ssize_t pwrite64(int fd, const void *buffer, size_t count, off64_t offset) {
+    return pwrite(fd, buffer, count, static_cast<off_t>(offset));
+}
+
+FSEAM_WEAK int fsync(int fd) {
+    FSeam::SyscallScope::count(FSeam::Syscall::FSYNC);
+    return static_cast<int>(syscall(SYS_fsync, fd));
+}
+
+FSEAM_WEAK int fdatasync(int fd) {
+    FSeam::SyscallScope::count(FSeam::Syscall::FDATASYNC);
+    return static_cast<int>(syscall(SYS_fdatasync, fd));
+}
+
+FSEAM_WEAK void *mmap(void *address, size_t length, int protection, int flags, int fd, off_t offset) __THROW {
+    FSeam::SyscallScope::count(FSeam::Syscall::MMAP, static_cast<std::int64_t>(length));
+    return reinterpret_cast<void *>(syscall(SYS_mmap, address, length, protection, flags, fd, offset));
+}
+
+FSEAM_WEAK void *mmap64(void *address, size_t length, int protection, int flags, int fd, off64_t offset) __THROW {
+    return mmap(address, length, protection, flags, fd, static_cast<off_t>(offset));
+}
+
+FSEAM_WEAK int clock_gettime(clockid_t clockId, struct timespec *tp) __THROW {
+    FSeam::SyscallScope::count(FSeam::Syscall::CLOCK_GETTIME);
+    return realGetTime()(clockId, tp);
+}
+
+FSEAM_WEAK int epoll_wait(int epfd, struct epoll_event *events, int maxEvents, int timeout) {
+    FSeam::SyscallScope::count(FSeam::Syscall::EPOLL_WAIT);
+    return static_cast<int>(syscall(SYS_epoll_pwait, epfd, events, maxEvents, timeout, nullptr, _NSIG / 8));
+}
+
+FSEAM_WEAK int epoll_pwait(int epfd, struct epoll_event *events, int maxEvents, int timeout, const sigset_t *sigmask) {
+    FSeam::SyscallScope::count(FSeam::Syscall::EPOLL_WAIT);
+    return static_cast<int>(syscall(SYS_epoll_pwait, epfd, events, maxEvents, timeout, sigmask, _NSIG / 8));
+}
+
+}
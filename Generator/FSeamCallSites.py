@@ -0,0 +1,69 @@
+#! /usr/bin/env python
+# MIT License
+#
+# Copyright (c) 2019 Quentin Balland
+# Project : https://github.com/FreeYourSoul/FSeam
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import subprocess
+import sys
+
+
+def _readCallSites(path):
+    with open(path) as _file:
+        for line in _file:
+            _fields = line.rstrip("\n").split("\t")
+            if len(_fields) == 4:
+                yield int(_fields[0]), _fields[1], _fields[2], int(_fields[3], 16)
+
+
+def symbolizeCallSites(path, addr2line="addr2line"):
+    """
+    Client exposed method, symbolize the call sites written by FSeam::report::writeCallSites with addr2line (one call
+    per module). The recorded offsets are return addresses, the call instruction is the one just before.
+    :param path: call sites file (calls, method key, module, offset per line)
+    :return: list of (calls, method key, function, location) sorted by decreasing number of calls
+    """
+    _callSites = list(_readCallSites(path))
+    _modules = dict()
+    for _, _, module, offset in _callSites:
+        _modules.setdefault(module, set()).add(offset)
+    _symbols = dict()
+    for module, offsets in _modules.items():
+        _offsets = sorted(offsets)
+        if not module:
+            continue
+        _output = subprocess.run([addr2line, "-f", "-C", "-e", module] + [hex(offset - 1) for offset in _offsets],
+                                 check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout.splitlines()
+        for i, offset in enumerate(_offsets):
+            _symbols[(module, offset)] = (_output[2 * i], _output[2 * i + 1])
+    _result = list()
+    for calls, key, module, offset in _callSites:
+        _function, _location = _symbols.get((module, offset), ("??", module + "+" + hex(offset)))
+        _result.append((calls, key, _function, _location))
+    return sorted(_result, key=lambda callSite: -callSite[0])
+
+
+if __name__ == '__main__':
+    _args = sys.argv[1:]
+    if len(_args) < 1:
+        raise NameError("Error missing argument: FSeamCallSites.py <call sites file> [addr2line]")
+    for _calls, _key, _function, _location in symbolizeCallSites(_args[0], *_args[1:2]):
+        print(str(_calls).rjust(10) + "  " + _key + "  <-  " + _function + " (" + _location + ")")
@@ -0,0 +1,113 @@
+#! /usr/bin/env python
+# MIT License
+#
+# Copyright (c) 2019 Quentin Balland
+# Project : https://github.com/FreeYourSoul/FSeam
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import filecmp
+import os
+import shutil
+import sys
+import tempfile
+import time
+
+import FSeamerFile
+
+PARAM_TYPES = ["int", "const std::string &", "std::vector<int>", "double", "const source::Payload &", "bool"]
+RETURN_TYPES = ["void", "int", "std::string", "source::Payload", "bool", "std::vector<int>"]
+
+
+def generateCorpus(folder, headers, classesPerHeader, methodsPerClass):
+    """
+    Write a synthetic corpus of headers to mock: each header declares classes with methods of various signatures
+    :return: paths of the generated headers
+    """
+    _paths = list()
+    with open(os.path.join(folder, "Payload.hh"), "w") as _file:
+        _file.write("#pragma once\n#include <string>\n\nnamespace source {\n    struct Payload { int id; std::string content; };\n}\n")
+    for h in range(headers):
+        _content = "#pragma once\n#include <string>\n#include <vector>\n#include <Payload.hh>\n\nnamespace source {\n"
+        for c in range(classesPerHeader):
+            _content += "\n    class Service" + str(h) + "_" + str(c) + " {\n    public:\n"
+            for m in range(methodsPerClass):
+                _params = ", ".join(PARAM_TYPES[(m + p) % len(PARAM_TYPES)] + " arg" + str(p) for p in range(m % 4))
+                _content += "        " + RETURN_TYPES[(h + m) % len(RETURN_TYPES)] + " call" + str(m) + "(" + _params + ");\n"
+            _content += "    };\n"
+        _content += "\n}\n"
+        _path = os.path.join(folder, "Service" + str(h) + ".hh")
+        with open(_path, "w") as _file:
+            _file.write(_content)
+        _paths.append(_path)
+    return _paths
+
+
+def _run(headers, destination, jobs):
+    if os.path.exists(destination):
+        shutil.rmtree(destination)
+    os.makedirs(destination)
+    _stdout = sys.stdout
+    sys.stdout = open(os.devnull, "w")
+    try:
+        _start = time.perf_counter()
+        FSeamerFile.generateFSeamFiles(headers, destination, True, (), jobs)
+        return time.perf_counter() - _start
+    finally:
+        sys.stdout.close()
+        sys.stdout = _stdout
+
+
+def benchmark(headers=200, classesPerHeader=3, methodsPerClass=12, jobs=(1, 2, 4, 0)):
+    """
+    Time the batch generation of a synthetic corpus with several numbers of jobs, the generated files of each run are
+    checked to be identical to the ones of the sequential run (deterministic merge)
+    :return: True if all the runs generated the same files
+    """
+    _folder = tempfile.mkdtemp(prefix="fseam-benchmark-")
+    _identical = True
+    try:
+        _headers = generateCorpus(_folder, headers, classesPerHeader, methodsPerClass)
+        print("FSeam generator benchmark: " + str(headers) + " headers, " + str(headers * classesPerHeader) +
+              " classes, " + str(headers * classesPerHeader * methodsPerClass) + " methods")
+        _reference = None
+        _sequential = None
+        for j in jobs:
+            _destination = os.path.join(_folder, "generated-" + str(j))
+            _elapsed = _run(list(reversed(_headers)) if j != 1 else _headers, _destination, j)
+            _sequential = _sequential or _elapsed
+            _files = sorted(os.listdir(_destination))
+            _same = True
+            if _reference is None:
+                _reference = _destination
+            else:
+                _match, _mismatch, _errors = filecmp.cmpfiles(_reference, _destination, _files, shallow=False)
+                _same = not _mismatch and not _errors and _files == sorted(os.listdir(_reference))
+                _identical &= _same
+            print("  jobs " + (str(j) if j > 0 else str(FSeamerFile._availableCpus()) + " (0)").ljust(8) + "%8.2fs" % _elapsed +
+                  "  x%.2f" % (_sequential / _elapsed) + ("" if _same else "  OUTPUT DIFFERS FROM jobs 1"))
+    finally:
+        shutil.rmtree(_folder)
+    return _identical
+
+
+if __name__ == '__main__':
+    # FSeamGeneratorBenchmark.py [number of headers] [classes per header] [methods per class]
+    _args = [int(a) for a in sys.argv[1:]]
+    sys.exit(0 if benchmark(*_args) else 1)
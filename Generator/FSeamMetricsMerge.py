@@ -0,0 +1,105 @@
+#! /usr/bin/env python
+# MIT License
+#
+# Copyright (c) 2019 Quentin Balland
+# Project : https://github.com/FreeYourSoul/FSeam
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import glob
+import json
+import os
+import re
+import sys
+
+METRICS = [("calls", "fseam_mock_calls", "Number of calls of the mocked method"),
+           ("expectationHits", "fseam_mock_expectation_hits", "Number of calls matching an expectation"),
+           ("capturedBytes", "fseam_mock_captured_bytes", "Number of bytes captured by the arguments")]
+OPEN_METRICS_LINE = re.compile(r'^(\w+)_total\{(.*)\} (\d+)$')
+OPEN_METRICS_LABEL = re.compile(r'(\w+)="([^"]*)"')
+
+
+def _readJson(path):
+    with open(path) as _file:
+        _content = json.load(_file)
+    for method in _content["methods"]:
+        yield _content["binary"], method["class"], method["method"], {m[0]: method[m[0]] for m in METRICS}
+
+
+def _readOpenMetrics(path):
+    _names = {m[1]: m[0] for m in METRICS}
+    with open(path) as _file:
+        for line in _file:
+            _match = OPEN_METRICS_LINE.match(line.strip())
+            if _match is None or _match.group(1) not in _names:
+                continue
+            _labels = dict(OPEN_METRICS_LABEL.findall(_match.group(2)))
+            yield _labels["binary"], _labels["class"], _labels["method"], {_names[_match.group(1)]: int(_match.group(3))}
+
+
+def mergeMetrics(paths):
+    """
+    Client exposed method, merge the metrics files written by the test binaries (one per shard, see FSeam::Metrics)
+    :param paths: metrics files (.fseam-metrics.json or .fseam-metrics.prom) or directories containing them
+    :return: tuple (number of merged files, metrics per (binary, class, method) sorted by key)
+    """
+    _files = list()
+    for path in paths:
+        if os.path.isdir(path):
+            _files += sorted(glob.glob(os.path.join(path, "*.fseam-metrics.json")))
+            _files += sorted(glob.glob(os.path.join(path, "*.fseam-metrics.prom")))
+        else:
+            _files.append(path)
+    _merged = dict()
+    for path in _files:
+        _reader = _readJson if path.endswith(".json") else _readOpenMetrics
+        for binary, className, methodName, values in _reader(path):
+            _metrics = _merged.setdefault((binary, className, methodName), {m[0]: 0 for m in METRICS})
+            for name, value in values.items():
+                _metrics[name] += value
+    return len(_files), sorted(_merged.items())
+
+
+def formatJson(shards, merged):
+    _methods = list()
+    for (binary, className, methodName), values in merged:
+        _method = {"binary": binary, "class": className, "method": methodName}
+        _method.update(values)
+        _methods.append(_method)
+    return json.dumps({"shards": shards, "methods": _methods}, indent=2) + "\n"
+
+
+def formatOpenMetrics(shards, merged):
+    _content = ""
+    for name, metric, description in METRICS:
+        _content += "# TYPE " + metric + " counter\n# HELP " + metric + " " + description + "\n"
+        for (binary, className, methodName), values in merged:
+            _content += metric + "_total{binary=\"" + binary + "\",class=\"" + className + "\",method=\"" + \
+                        methodName + "\"} " + str(values[name]) + "\n"
+    return _content + "# EOF\n"
+
+
+if __name__ == '__main__':
+    _args = sys.argv[1:]
+    if len(_args) < 2:
+        raise NameError("Error missing argument for merge: FSeamMetricsMerge.py <output(.json|.prom)> <files or directories>...")
+    _shards, _merged = mergeMetrics(_args[1:])
+    with open(_args[0], "w") as _output:
+        _output.write(formatOpenMetrics(_shards, _merged) if _args[0].endswith(".prom") else formatJson(_shards, _merged))
+    print("FSeam merged " + str(_shards) + " metrics files into " + _args[0])
@@ -0,0 +1,96 @@
+#! /usr/bin/env python
+# MIT License
+#
+# Copyright (c) 2019 Quentin Balland
+# Project : https://github.com/FreeYourSoul/FSeam
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import subprocess
+import sys
+
+REAL_SYMBOL_PREFIX = "__fseam_real_"
+
+
+def _definedSymbols(nm, objects):
+    """
+    :return: set of the global symbols defined in the text section of the given objects
+    """
+    _symbols = set()
+    for obj in objects:
+        _output = subprocess.run([nm, "--defined-only", "--extern-only", obj],
+                                 check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+        for line in _output.splitlines():
+            _fields = line.split()
+            if len(_fields) == 3 and _fields[1] == "T":
+                _symbols.add(_fields[2])
+    return _symbols
+
+
+def generateSpyObject(output, wrappers, objects, nm="nm", ld="ld", objcopy="objcopy"):
+    """
+    Client exposed method, link the original implementation of the spied headers into a relocatable object in which
+    the spied methods are renamed (prefixed by __fseam_real_): the spy wrappers (<header>.fseam.spy.cc) are then
+    resolved by the rest of the test, while the forwarders (<header>.fseam.forward.cc, part of the given objects)
+    still call the original implementation.
+    :param output: path of the relocatable object to create
+    :param wrappers: objects compiled from the spy wrappers
+    :param objects: objects compiled from the original implementation and the forwarders, each spied method has to be
+                    defined in those objects (NameError raised otherwise)
+    :return: no return
+    """
+    _spied = _definedSymbols(nm, wrappers)
+    _real = _definedSymbols(nm, objects)
+    if _spied - _real:
+        # the forwarder would resolve the spy itself (infinite recursion at the first call)
+        raise NameError("Error no original implementation found for the spied symbols " +
+                        " ".join(sorted(_spied - _real)) + " (mock the header instead of spying it, or provide the "
+                        "implementation of those methods)")
+
+    _merged = output + ".merged.o"
+    subprocess.run([ld, "-r", "-o", _merged] + objects, check=True)
+    _redefineFile = output + ".syms"
+    with open(_redefineFile, "w") as _file:
+        for symbol in sorted(_spied & _real):
+            _file.write(symbol + " " + REAL_SYMBOL_PREFIX + symbol + "\n")
+    subprocess.run([objcopy, "--redefine-syms=" + _redefineFile, _merged, output], check=True)
+    os.remove(_merged)
+    print("FSeam spy object generated at " + output + " (" + str(len(_spied & _real)) + " spied symbols)")
+
+
+def _parseArguments(args):
+    _options = {"--output": [], "--wrappers": [], "--objects": [], "--nm": [], "--ld": [], "--objcopy": []}
+    _current = None
+    for arg in args:
+        if arg in _options:
+            _current = _options[arg]
+        elif _current is None:
+            raise NameError("Error unexpected argument " + arg)
+        else:
+            _current.append(arg)
+    if len(_options["--output"]) != 1 or not _options["--objects"]:
+        raise NameError("Error missing argument for spy object generation")
+    return _options
+
+
+if __name__ == '__main__':
+    _opts = _parseArguments(sys.argv[1:])
+    generateSpyObject(_opts["--output"][0], _opts["--wrappers"], _opts["--objects"],
+                      (_opts["--nm"] or ["nm"])[0], (_opts["--ld"] or ["ld"])[0], (_opts["--objcopy"] or ["objcopy"])[0])
@@ -22,6 +22,7 @@
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 # SOFTWARE.
 
+import multiprocessing
 import ntpath
 import os
 import re
@@ -46,15 +47,18 @@ BASE_HEADER_CODE = "#include "
 PARAM_SUFFIX = "_ParamValue"
 FREE_FUNC_FAKE_CLASS = "FreeFunction"
 RETURN_SUFFIX = "_ReturnValue"
+SPY_FORWARD_PREFIX = "fseamReal_"
 
 
 class FSeamerFile:
 
     # =====Public methods =====
 
-    def __init__(self, pathFile):
+    def __init__(self, pathFile, spy=False):
         """
         :param pathFile: cpp header file that will be parsed at the "seamParse" call
+        :param spy: if True, the generated methods forward the calls to the original implementation (spy mode) instead
+                    of replacing it, see getSpyForwardContent
         """
         self.mapClassMethods = {}
         self.codeSeam = HEADER_INFO
@@ -67,11 +71,16 @@ class FSeamerFile:
         self.freeFunctionClassMethodId = None
         self.freeFunctionDataStructContent = None
         self.freeFunctionTemplateSpecContent = ""
+        self.spy = spy
+        self.spyForwardDeclarations = ""
+        self.spyForwardDefinitions = ""
+        self.spyForwardCount = 0
         try:
             self.cppHeader = CppHeaderParser.CppHeader(self.headerPath)
         except CppHeaderParser.CppParseError as e:
             print(e)
             sys.exit(1)
+        self.includes = self.cppHeader.includes
 
     def seamParse(self):
         """
@@ -89,7 +98,8 @@ class FSeamerFile:
                 self.fullClassNameMap[c] = _classes[c]["namespace"] + "::" + _className
             for encapsulationLevel in _classes[c]["methods"]:
                 self.codeSeam += "\n// " + _className + " " + encapsulationLevel
-                self.codeSeam += self._extractMethodsFromClass(_className, _classes[c]["methods"][encapsulationLevel])
+                self.codeSeam += self._extractMethodsFromClass(_className, _classes[c]["methods"][encapsulationLevel],
+                                                               encapsulationLevel == "public")
             self.codeSeam = self.codeSeam.replace(CLASSNAME, _className)
         self.cppHeader.functions.extend(self.staticFunction)
         if len(self.cppHeader.functions) > 0:
@@ -102,8 +112,27 @@ class FSeamerFile:
                 self.codeSeam += self._extractFreeFunctions(functionData)
             self.mapClassMethods[FREE_FUNC_FAKE_CLASS] = _listFunc
             self.fullClassNameMap[FREE_FUNC_FAKE_CLASS] = FREE_FUNC_FAKE_CLASS
+        if self.spy:
+            self.codeSeam = self.codeSeam.replace("// includes\n", "// includes\n#include <chrono>\n", 1)
+            self.codeSeam = self.codeSeam.replace(BASE_HEADER_CODE + "<" + self.fileName + ">\n",
+                                                  BASE_HEADER_CODE + "<" + self.fileName + ">\n\n" +
+                                                  "// Forwarders to the original implementation (see " +
+                                                  self.getFSeamForwardFileName() + ")\n" +
+                                                  self.spyForwardDeclarations, 1)
         return self.codeSeam
 
+    def getSpyForwardContent(self):
+        """
+        Spy mode only: content of the forwarder file. Each forwarder calls the original implementation of a spied
+        method, it is compiled with the original implementation, and the references to the spied methods are renamed
+        afterward (see FSeamSpy.py) in order to not be resolved to the spy
+        :return: FSeam forwarder cpp content to be filed into a file (call seamParse first)
+        """
+        _content = HEADER_INFO.replace(FILENAME, self.fileName)
+        _content += self._extractHeaders().replace("#include <FSeamMockData.hpp>\n#include <FSeam/FSeam.hpp>\n", "")
+        _content += "#include <utility>\n"
+        return _content + self.spyForwardDefinitions
+
     def isSeamFileUpToDate(self, fileFSeamPath):
         """
         Check if the newly created file (the FSeam mock file) has been updated sooner than the header it is originated
@@ -112,17 +141,20 @@ class FSeamerFile:
         :return: True if the file given as parameter is more up to date than the initial header file used for its
                  generation
         """
-        if not os.path.exists(fileFSeamPath):
-            return False
-        fileMockedTime = os.stat(fileFSeamPath).st_mtime
-        fileToMockTime = os.stat(self.headerPath).st_mtime
-        return fileMockedTime > fileToMockTime
+        return _isSeamFileUpToDate(self.headerPath, fileFSeamPath)
 
     def getFSeamGeneratedFileName(self):
         """
         :return: name of the file to generate: <headerFileNameWithoutExtension>.fseam.cc
+                 (<headerFileNameWithoutExtension>.fseam.spy.cc in spy mode)
+        """
+        return _fSeamGeneratedFileName(self.fileName, self.spy)
+
+    def getFSeamForwardFileName(self):
+        """
+        :return: name of the forwarder file to generate in spy mode: <headerFileNameWithoutExtension>.fseam.forward.cc
         """
-        return self.fileName.replace(".hh", ".fseam.cc").replace("hpp", "fseam.cc")
+        return _fSeamForwardFileName(self.fileName)
 
     def generateDataStructureContent(self, content):
         """
@@ -143,7 +175,7 @@ class FSeamerFile:
         if not content or len(content) < 10:
             content = HEADER_INFO.replace(FILENAME, "DataMock.hpp")
             content += LOCKING_HEAD.replace(CLASSNAME, "DATAMOCK")
-            for incl in self.cppHeader.includes:
+            for incl in self.includes:
                 content += BASE_HEADER_CODE + incl + "\n"
             content += "#include <type_traits>\n"
             content += "#include <optional>\n"
@@ -153,21 +185,21 @@ class FSeamerFile:
         content += "namespace FSeam {\n"
         for className, methods in self.mapClassMethods.items():
             content += "//Beginning of " + className
-            if FREE_FUNC_FAKE_CLASS is className:
+            if FREE_FUNC_FAKE_CLASS == className:
                 self.freeFunctionDataStructContent = self._getCurrentFreeFunctionDataContent(content)
                 self.freeFunctionClassMethodId = self._getCurrentFreeFunctionClassMethodIdContent(content)
             if methods or className in content:
                 content = self._clearDataStructureData(content, className)
             _struct = "\nstruct " + className + "Data {\n"
-            if FREE_FUNC_FAKE_CLASS is className and self.freeFunctionDataStructContent is not None:
+            if FREE_FUNC_FAKE_CLASS == className and self.freeFunctionDataStructContent is not None:
                 _struct += self.freeFunctionDataStructContent
             for methodName in methods:
-                if FREE_FUNC_FAKE_CLASS is className:
+                if FREE_FUNC_FAKE_CLASS == className:
                     _struct += self._extractDataStructMethod(className, methodName, self.freeFunctionDataStructContent)
                 else:
                     _struct += self._extractDataStructMethod(className, methodName)
             content += _struct + "};\n\n"
-            if className is not FREE_FUNC_FAKE_CLASS:
+            if className != FREE_FUNC_FAKE_CLASS:
                 content += "// NameTypeTraits\ntemplate <> struct TypeParseTraits<" + self.fullClassNameMap[className] + \
                            "> {\n" + INDENT + "inline static const std::string ClassName = \"" + className + "\";\n};\n"
             if className in self.functionSignatureMapping:
@@ -188,7 +220,7 @@ class FSeamerFile:
             content = HEADER_INFO.replace(FILENAME, "FSeamSpecialization.hpp")
             content += "#include <FSeamMockData.hpp>\n\n"
         for className, methods in self.mapClassMethods.items():
-            if FREE_FUNC_FAKE_CLASS is className:
+            if FREE_FUNC_FAKE_CLASS == className:
                 for method in methods:
                     if method in self.freeFunctionTemplateSpecContent:
                         content = self._clearSpecializationFreeFunction(content, method)
@@ -200,7 +232,7 @@ class FSeamerFile:
 
     def _extractHeaders(self, ):
         _fseamerCodeHeaders = "// includes\n"
-        for incl in self.cppHeader.includes:
+        for incl in self.includes:
             _fseamerCodeHeaders += BASE_HEADER_CODE + incl + "\n"
         _fseamerCodeHeaders += "#include <functional>\n"
         _fseamerCodeHeaders += "#include <FSeamMockData.hpp>\n#include <FSeam/FSeam.hpp>\n"
@@ -253,10 +285,17 @@ class FSeamerFile:
                 _signature += ", "
         _signature += ")"
         _functionFakeClassMethod += "\n" + _signature + " {\n"
-        _functionFakeClassMethod += self._generateMethodContent(_returnType, FREE_FUNC_FAKE_CLASS, _functionName, True)
+        if self.spy:
+            _namespace = freeFunctionData.get("fseamNamespace", freeFunctionData["namespace"])
+            _forwarder = self._generateSpyForwarder(_namespace, None, False, _returnType, freeFunctionData["parameters"],
+                                                    freeFunctionData["namespace"] + _functionName)
+            _functionFakeClassMethod += self._generateSpyMethodContent(_returnType, FREE_FUNC_FAKE_CLASS, _functionName,
+                                                                       _forwarder, True)
+        else:
+            _functionFakeClassMethod += self._generateMethodContent(_returnType, FREE_FUNC_FAKE_CLASS, _functionName, True)
         return _functionFakeClassMethod + "\n}\n"
 
-    def _extractMethodsFromClass(self, className, methodsData):
+    def _extractMethodsFromClass(self, className, methodsData, isPublic=True):
         _methods = "\n// Methods Mocked Implementation for class " + className + "\n"
         _lstMethodName = list()
 
@@ -264,6 +303,7 @@ class FSeamerFile:
             _lstMethodName = self.mapClassMethods[className]
         for methodData in methodsData:
             if methodData["static"]:
+                methodData["fseamNamespace"] = methodData["namespace"]
                 methodData["namespace"] += className + "::"
                 self.staticFunction.append(methodData)
             elif not methodData["defined"]:
@@ -292,7 +332,15 @@ class FSeamerFile:
                     _signature += " const"
                 if methodData["noexcept"] is not None:
                     _signature += " noexcept"
-                methodContent = self._generateMethodContent(_returnType, className, _methodsName)
+                if self.spy:
+                    # constructors, destructors and non public methods are not spied: the original implementation is used
+                    if not isPublic or methodData["constructor"] or methodData["destructor"]:
+                        continue
+                    _forwarder = self._generateSpyForwarder(methodData["namespace"], _classFullName, methodData["const"],
+                                                            _returnType, methodData["parameters"], "self->" + _methodsName)
+                    methodContent = self._generateSpyMethodContent(_returnType, className, _methodsName, _forwarder)
+                else:
+                    methodContent = self._generateMethodContent(_returnType, className, _methodsName)
                 _methods += "\n" + _signature + " {\n" + methodContent + "\n}\n"
 
         self.mapClassMethods[className] = _lstMethodName
@@ -313,12 +361,12 @@ class FSeamerFile:
         _genSpecial += "}\n"
 
         _specContent = ""
-        if FREE_FUNC_FAKE_CLASS is not className:
+        if FREE_FUNC_FAKE_CLASS != className:
             _specContent = "\n\n// Duping/Expectations specializations for " + className + "\n"
         for methodName, methodMapping in self.functionSignatureMapping[className].items():
             if methodName.startswith("Destructor_"):
                 methodName.replace("Destructor_", "~")
-            if (FREE_FUNC_FAKE_CLASS is className):
+            if (FREE_FUNC_FAKE_CLASS == className):
                 _specContent += "// Generated duping for method " + className + "::" + methodName + " begin\n"
             # Specialization for dupeReturn
             if methodMapping["rtnType"].replace("static ", "") != "void":
@@ -333,13 +381,13 @@ class FSeamerFile:
                 _specContent += "// Expectation specializations for " + className + "::" + methodName + "\n"
                 for comparator in [None, "FSeam::IsNot", "FSeam::AtMost", "FSeam::AtLeast", "FSeam::NeverCalled", "FSeam::VerifyCompare"]:
                     _specContent += self._generateSpecializationVerifyArg(className, methodName, methodMapping, comparator)
-            if (FREE_FUNC_FAKE_CLASS is className):
+            if (FREE_FUNC_FAKE_CLASS == className):
                 _specContent += "// Generated duping for method " + className + "::" + methodName + " end\n"
         # cleanup loops last separator tokens
         _specContent = _specContent.replace(", >", ">").replace(", )", ")").replace(", \n);", ");").replace("(\n)", "()")
-        if FREE_FUNC_FAKE_CLASS is not className:
+        if FREE_FUNC_FAKE_CLASS != className:
             _specContent += "// End of Specialization for " + className + "\n\n"
-        if FREE_FUNC_FAKE_CLASS is className:
+        if FREE_FUNC_FAKE_CLASS == className:
             self.freeFunctionTemplateSpecContent = _specContent
         else:
             self.specContent += _specContent
@@ -377,12 +425,111 @@ class FSeamerFile:
         for p in self.functionSignatureMapping[className][methodName]["params"]:
             _content += INDENT + "if (std::is_copy_constructible<std::decay<" + p["type"].replace("& &", "&&") + ">>())\n"
             _content += INDENT2 + "data." + methodName + "_" + p["name"] + PARAM_SUFFIX + " = " + p["name"] + ";\n"
+        _hasReturn = 'void' != returnType and \
+                     self.functionSignatureMapping[className][methodName]["isConstructorOrDestructor"] is False
+        _content += INDENT + "FSEAM_PROBE_ENTRY(\"" + className + "\", __func__, &data);\n"
+        _content += self._generateCallSite()
         _content += INDENT + "mockVerifier->invokeDupedMethod(__func__, &data);\n"
-        _content += INDENT + "mockVerifier->methodCall(__func__, &data);\n"
-        if 'void' != returnType and self.functionSignatureMapping[className][methodName]["isConstructorOrDestructor"] is False:
+        if _hasReturn:
+            _content += INDENT + "mockVerifier->replayCall(__func__, data." + methodName + "_ReturnValue" + \
+                        self._extractCallArguments(className, methodName) + ");\n"
+        _content += INDENT + "mockVerifier->methodCall(__func__, &data" + self._extractCallArguments(className, methodName) + ");\n"
+        if _hasReturn:
+            _content += self._generateReturnedPayload("data." + methodName + "_ReturnValue")
+        _content += INDENT + "FSEAM_PROBE_EXIT(\"" + className + "\", __func__, &data);\n"
+        if _hasReturn:
             _content += INDENT + "return data." + methodName + "_ReturnValue;"
         return _content
 
+    @staticmethod
+    def _generateCallSite():
+        """
+        :return: opt-in registration of the return address of the mocked method (see FSeam::report::enableCallSites)
+        """
+        return INDENT + "if (FSeam::report::Settings::callSites)\n" + \
+               INDENT2 + "mockVerifier->callSite(__func__, __builtin_return_address(0));\n"
+
+    @staticmethod
+    def _generateReturnedPayload(returnValue):
+        """
+        :return: opt-in accounting of the bytes returned by the mocked method (see FSeam::report::enablePayload)
+        """
+        return INDENT + "if (FSeam::report::Settings::payload)\n" + \
+               INDENT2 + "mockVerifier->returnedPayload(__func__, " + returnValue + ");\n"
+
+    def _generateSpyForwarder(self, namespace, selfType, isConst, returnType, params, callee):
+        """
+        Generate the declaration (into the spy file) and the definition (into the forwarder file) of a function
+        calling the original implementation of a spied method
+        :return: name of the forwarder function (qualified)
+        """
+        _name = SPY_FORWARD_PREFIX + re.sub(r"\W", "_", os.path.splitext(self.fileName)[0]) + "_" + str(self.spyForwardCount)
+        self.spyForwardCount += 1
+        _namespace = namespace.rstrip(":")
+        _parameters = list()
+        _arguments = list()
+        if selfType is not None:
+            _parameters.append(("const " if isConst else "") + selfType + " *self")
+        for i, p in enumerate(params):
+            _paramType = p["type"].replace("& &", "&&")
+            _paramName = p["name"] if p["name"] not in ["&", "", None, "*", "&&"] else "arg" + str(i)
+            _parameters.append(_paramType + " " + _paramName)
+            if "&" not in _paramType or "&&" in _paramType:
+                _arguments.append("std::move(" + _paramName + ")")
+            else:
+                _arguments.append(_paramName)
+        _declaration = returnType + " " + _name + "(" + ", ".join(_parameters) + ")"
+        _body = " {\n" + INDENT + "return " + callee + "(" + ", ".join(_arguments) + ");\n}\n"
+        if len(_namespace) > 0:
+            self.spyForwardDeclarations += "namespace " + _namespace + " { " + _declaration + "; }\n"
+            self.spyForwardDefinitions += "\nnamespace " + _namespace + " {\n" + _declaration + _body + "}\n"
+            return _namespace + "::" + _name
+        self.spyForwardDeclarations += _declaration + ";\n"
+        self.spyForwardDefinitions += "\n" + _declaration + _body
+        return _name
+
+    def _generateSpyMethodContent(self, returnType, className, methodName, forwarder, isFreeFunction=False):
+        _content = self._generateMethodContent(returnType, className, methodName, isFreeFunction)
+        _content = _content[0:_content.find(INDENT + "FSEAM_PROBE_ENTRY(")]
+        _content += INDENT + "FSEAM_PROBE_ENTRY(\"" + className + "\", __func__, &data);\n"
+        _content += self._generateCallSite()
+        _arguments = list()
+        if not isFreeFunction:
+            _arguments.append("this")
+        for i, p in enumerate(self.functionSignatureMapping[className][methodName]["params"]):
+            _paramName = p["name"] if p["name"] not in ["&", "", None, "*", "&&"] else "arg" + str(i)
+            if "&&" in p["type"].replace("& &", "&&"):
+                _paramName = "std::move(" + _paramName + ")"
+            _arguments.append(_paramName)
+        _call = forwarder + "(" + ", ".join(_arguments) + ");\n"
+        _content += INDENT + "mockVerifier->invokeDupedMethod(__func__, &data);\n"
+        _content += INDENT + "auto fseamSpyStart = std::chrono::steady_clock::now();\n"
+        if "void" != returnType:
+            _content += INDENT + "decltype(auto) fseamSpyReturn = " + _call
+        else:
+            _content += INDENT + _call
+        _content += INDENT + "mockVerifier->spyCall(__func__, std::chrono::steady_clock::now() - fseamSpyStart);\n"
+        if "void" != returnType:
+            _returnValue = "data." + methodName + RETURN_SUFFIX
+            _content += INDENT + "if constexpr (std::is_assignable<decltype((" + _returnValue + ")), decltype((fseamSpyReturn))>::value)\n"
+            _content += INDENT2 + _returnValue + " = fseamSpyReturn;\n"
+        _content += INDENT + "mockVerifier->methodCall(__func__, &data" + self._extractCallArguments(className, methodName) + ");\n"
+        if "void" != returnType:
+            _content += INDENT + "mockVerifier->recordCall(__func__, fseamSpyReturn" + \
+                        self._extractCallArguments(className, methodName) + ");\n"
+            _content += self._generateReturnedPayload("fseamSpyReturn")
+        _content += INDENT + "FSEAM_PROBE_EXIT(\"" + className + "\", __func__, &data);\n"
+        if "void" != returnType:
+            _content += INDENT + "return fseamSpyReturn;"
+        return _content
+
+    def _extractCallArguments(self, className, methodName):
+        _arguments = ""
+        for p in self.functionSignatureMapping[className][methodName]["params"]:
+            if p["name"] not in ["&", "", None, "*", "&&"]:
+                _arguments += ", " + p["name"]
+        return _arguments
+
     @staticmethod
     def _generateSpecializationVerifyArg(className, methodName, methodMapping, comparator=None):
         _gen = "template <> void FSeam::MockClassVerifier::expectArg<FSeam::" + className + "::" + methodName + ", "
@@ -417,8 +564,8 @@ class FSeamerFile:
 
     @staticmethod
     def _clearDataStructureData(content, className):
-        indexBegin = content.find("//Beginning of " + className)
-        indexEnd = content.find("// End of DataStructure" + className) + len("// End of DataStructure" + className)
+        indexBegin = content.find("//Beginning of " + className + "\n")
+        indexEnd = content.find("// End of DataStructure" + className + "\n") + len("// End of DataStructure" + className)
         if indexBegin > 0 and indexEnd > len("// End of DataStructure" + className) + 1:
             content = content[0: indexBegin] + content[indexEnd + 1:]
         return content
@@ -442,7 +589,164 @@ class FSeamerFile:
         return content
 
 
-def generateFSeamFile(filePath, destinationFolder, forceGeneration=False):
+def _checkHeaderExtension(filePath):
+    if not str.endswith(filePath, ".hh") and not str.endswith(filePath, ".hpp") and not str.endswith(filePath, ".h"):
+        raise NameError("Error file " + filePath + " is not a .hh (or .hpp .h) file")
+
+
+def _fSeamGeneratedFileName(fileName, spy):
+    if spy:
+        return os.path.splitext(fileName)[0] + ".fseam.spy.cc"
+    return fileName.replace(".hh", ".fseam.cc").replace("hpp", "fseam.cc")
+
+
+def _fSeamForwardFileName(fileName):
+    return os.path.splitext(fileName)[0] + ".fseam.forward.cc"
+
+
+def _isSeamFileUpToDate(headerPath, fileFSeamPath, stampPath=None):
+    """
+    :return: True if the FSeam file exists and is newer than the header. The generated files are only rewritten when
+             their content changes, an unchanged FSeam file keeps its time: the header is then compared to the stamp of
+             the last complete generation (if any) as well
+    """
+    if not os.path.exists(fileFSeamPath):
+        return False
+    _generatedTime = os.stat(fileFSeamPath).st_mtime
+    if stampPath is not None and os.path.exists(stampPath):
+        _generatedTime = max(_generatedTime, os.stat(stampPath).st_mtime)
+    return _generatedTime > os.stat(headerPath).st_mtime
+
+
+def _generateSeamFile(filePath, destinationFolder, forceGeneration, spy, stampPath=None):
+    """
+    Generate the FSeam mock file (and the forwarder file in spy mode) of a header, the header is only parsed if its
+    generated file isn't up to date (or if the generation is forced). The generated files are only written if their
+    content changed: a regeneration doesn't recompile the mocks it didn't modify
+    :return: the FSeamerFile used for the generation, None if the generated file is already up to date
+    """
+    _checkHeaderExtension(filePath)
+    _fileName = _fSeamGeneratedFileName(ntpath.basename(filePath), spy)
+    _fileFSeamPath = os.path.normpath(destinationFolder + "/" + _fileName)
+    if not forceGeneration and _isSeamFileUpToDate(filePath, _fileFSeamPath, stampPath):
+        print("FSeam file is already generated at path " + _fileFSeamPath)
+        return None
+
+    _fSeamerFile = FSeamerFile(filePath, spy)
+    _writeFileIfChanged(_fileFSeamPath, _fSeamerFile.seamParse())
+    print("FSeam generated file " + _fileName + " at " + os.path.abspath(destinationFolder))
+    if spy:
+        _fileForwardName = _fSeamerFile.getFSeamForwardFileName()
+        _writeFileIfChanged(os.path.normpath(destinationFolder + "/" + _fileForwardName),
+                            _fSeamerFile.getSpyForwardContent())
+        print("FSeam generated file " + _fileForwardName + " at " + os.path.abspath(destinationFolder))
+    return _fSeamerFile
+
+
+def _generateSeamFileTask(task):
+    """
+    Parallel generation worker: generate the files of a header, the parser state (not needed to update the shared
+    files) is dropped before the FSeamerFile is sent back to the main process
+    """
+    try:
+        _fSeamerFile = _generateSeamFile(*task)
+    except SystemExit:
+        raise RuntimeError("Error while parsing " + task[0])
+    if _fSeamerFile is not None:
+        _fSeamerFile.cppHeader = None
+    return _fSeamerFile
+
+
+def _readFile(path):
+    if not os.path.exists(path):
+        return ""
+    with open(path, "r") as _file:
+        return _file.read()
+
+
+def _writeFileIfChanged(path, content):
+    """
+    Write the file only if its content changed: the files shared by all the generated mocks (FSeamMockData.hpp
+    included by every test source) are not touched when a batch doesn't modify them, to not trigger a full rebuild
+    """
+    if _readFile(path) == content:
+        return
+    with open(path, "w") as _file:
+        _file.write(content)
+
+
+def _touch(path):
+    with open(path, "a"):
+        os.utime(path, None)
+
+
+def _cmakeBool(value):
+    """
+    :return: the boolean value of a CMake boolean constant (1, ON, YES, TRUE, Y, ... are true; 0, OFF, NO, FALSE, N,
+             IGNORE, NOTFOUND, the empty string and <name>-NOTFOUND are false, whatever the case)
+    """
+    _value = str(value).strip().upper()
+    return not (_value in ["", "0", "OFF", "NO", "FALSE", "N", "IGNORE", "NOTFOUND"] or _value.endswith("-NOTFOUND"))
+
+
+def _availableCpus():
+    if hasattr(os, "sched_getaffinity"):
+        return len(os.sched_getaffinity(0))
+    return os.cpu_count() or 1
+
+
+def generateFSeamFiles(filePaths, destinationFolder, forceGeneration=False, spyFilePaths=(), jobs=1, stampPath=None):
+    """
+    Client exposed method, batch generation: create the FSeam mock file of each header, and update the files shared by
+    all the mocks (FSeamMockData.hpp and FSeamSpecialization.cpp) only once for the whole batch
+
+    :param filePaths: paths of the cpp header files to mock
+    :param destinationFolder: folder in which the generated files will be created
+    :param forceGeneration: see generateFSeamFile, an up to date header is skipped if not set
+    :param spyFilePaths: paths of the cpp header files to spy (see generateFSeamFile spy parameter)
+    :param jobs: number of processes parsing the headers and generating their files (0 for one per CPU), the shared
+                 files are always merged by the calling process, in the sorted order of the headers: the generated
+                 files don't depend on the number of jobs nor on the order of the given headers
+    :param stampPath: stamp file touched once the whole batch is generated (used as output of the build system
+                      command, the generated files being only rewritten when their content changes), an up to date
+                      header is also checked against it
+    :return: no return
+    """
+    _tasks = sorted([(os.path.normpath(f), destinationFolder, forceGeneration, False, stampPath) for f in filePaths] +
+                    [(os.path.normpath(f), destinationFolder, forceGeneration, True, stampPath) for f in spyFilePaths],
+                    key=lambda task: (task[3], task[0]))
+    _jobs = min(jobs if jobs > 0 else _availableCpus(), len(_tasks))
+    if _jobs > 1:
+        with multiprocessing.Pool(_jobs) as _pool:
+            _generated = _pool.map(_generateSeamFileTask, _tasks, chunksize=1)
+    else:
+        _generated = [_generateSeamFile(*task) for task in _tasks]
+    _generated = [f for f in _generated if f is not None]
+    if _generated:
+        _updateSharedFiles(_generated, destinationFolder)
+    if stampPath is not None:
+        _touch(stampPath)
+
+
+def _updateSharedFiles(generated, destinationFolder):
+    """
+    Merge the generated mocks into the files shared by all the mocks (FSeamMockData.hpp and FSeamSpecialization.cpp)
+    """
+    _fileCreatedMockDataPath = os.path.normpath(destinationFolder + "/FSeamMockData.hpp")
+    _fileCreatedMockDataContent = _readFile(_fileCreatedMockDataPath)
+    _fileCreatedSpecializationPath = os.path.normpath(destinationFolder + "/FSeamSpecialization.cpp")
+    _fileCreatedSpecializationContent = _readFile(_fileCreatedSpecializationPath)
+    for _fSeamerFile in generated:
+        _fileCreatedMockDataContent = _fSeamerFile.generateDataStructureContent(
+            _fileCreatedMockDataContent.replace(LOCKING_FOOTER, ""))
+        _fileCreatedSpecializationContent = _fSeamerFile.getSpecializationContent(_fileCreatedSpecializationContent)
+    _writeFileIfChanged(_fileCreatedMockDataPath, _fileCreatedMockDataContent)
+    print("FSeam generated file FSeamMockData.hpp at " + os.path.abspath(destinationFolder))
+    _writeFileIfChanged(_fileCreatedSpecializationPath, _fileCreatedSpecializationContent)
+    print("FSeam generated file FSeamSpecialization.cpp at " + os.path.abspath(destinationFolder))
+
+
+def generateFSeamFile(filePath, destinationFolder, forceGeneration=False, spy=False):
     """
     Client exposed method, will create the FSeam mock file and fill them with the content provided by the FSeam parser
 
@@ -452,45 +756,64 @@ def generateFSeamFile(filePath, destinationFolder, forceGeneration=False):
                             make it able to bypass those check and to generate brand new mock anyway (the FSeamMockData.hpp
                             won't be deleted, the usual process of removing only the part re-generated will stays as is)
                             by default, this flag is set to False
+    :param spy: generate a spy (forwarding to the original implementation) instead of a mock, a forwarder file
+                <headerFileNameWithoutExtension>.fseam.forward.cc is generated as well
     :return: no return
     """
-    if not str.endswith(filePath, ".hh") and not str.endswith(filePath, ".hpp") and not str.endswith(filePath, ".h"):
-        raise NameError("Error file " + filePath + " is not a .hh (or .hpp .h) file")
-
-    _fSeamerFile = FSeamerFile(filePath)
-    _fileName = _fSeamerFile.getFSeamGeneratedFileName()
-    _fileFSeamPath = os.path.normpath(destinationFolder + "/" + _fileName)
-    if not forceGeneration and _fSeamerFile.isSeamFileUpToDate(_fileFSeamPath):
-        print("FSeam file is already generated at path " + _fileFSeamPath)
-        return
+    if spy:
+        generateFSeamFiles([], destinationFolder, forceGeneration, [filePath])
+    else:
+        generateFSeamFiles([filePath], destinationFolder, forceGeneration)
 
-    with open(_fileFSeamPath, "w") as _fileCreated:
-        _fileCreated.write(_fSeamerFile.seamParse())
-    print("FSeam generated file " + _fileName + " at " + os.path.abspath(destinationFolder))
 
-    _fileCreatedMockDataPath = os.path.normpath(destinationFolder + "/FSeamMockData.hpp")
-    _fileCreatedMockDataContent = ""
-    if os.path.exists(_fileCreatedMockDataPath):
-        with open(_fileCreatedMockDataPath, "r") as _fileCreatedMockData:
-            _fileCreatedMockDataContent = _fileCreatedMockData.read().replace(LOCKING_FOOTER, "")
-    with open(_fileCreatedMockDataPath, "w") as _fileCreatedMockData:
-        _fileCreatedMockData.write(_fSeamerFile.generateDataStructureContent(_fileCreatedMockDataContent))
-    print("FSeam generated file FSeamMockData.hpp at " + os.path.abspath(destinationFolder))
-    _fileCreatedSpecializationPath = os.path.normpath(destinationFolder + "/FSeamSpecialization.cpp")
-    _fileCreatedSpecializationContent = ""
-    if os.path.exists(_fileCreatedSpecializationPath):
-        with open(_fileCreatedSpecializationPath, "r") as _fileCreatedSpecData:
-            _fileCreatedSpecializationContent = _fileCreatedSpecData.read()
-    with open(_fileCreatedSpecializationPath, "w") as _fileCreatedSpecData:
-        _fileCreatedSpecData.write(_fSeamerFile.getSpecializationContent(_fileCreatedSpecializationContent))
-    print("FSeam generated file FSeamSpecialization.cpp at " + os.path.abspath(destinationFolder))
+def _expandResponseFiles(args):
+    """
+    :return: arguments in which each @<file> is replaced by the content of the response file (one argument per line,
+             empty lines and lines starting with # are ignored)
+    """
+    _expanded = list()
+    for arg in args:
+        if not arg.startswith("@"):
+            _expanded.append(arg)
+            continue
+        with open(arg[1:], "r") as _responseFile:
+            for line in _responseFile.read().splitlines():
+                line = line.strip()
+                if line and not line.startswith("#"):
+                    _expanded.append(line)
+    return _expanded
+
+
+def _parseBatchArguments(args):
+    _options = {"--destination": [], "--mock": [], "--spy": [], "--force": [], "--jobs": [], "--stamp": []}
+    _current = None
+    for arg in args:
+        if arg in _options:
+            _current = _options[arg]
+        elif _current is None:
+            raise NameError("Error unexpected argument " + arg)
+        else:
+            _current.append(arg)
+    if len(_options["--destination"]) != 1 or not (_options["--mock"] or _options["--spy"]):
+        raise NameError("Error missing argument for batch generation")
+    return _options
 
 
 if __name__ == '__main__':
-    _args = sys.argv[1:]
+    _argv = _expandResponseFiles(sys.argv[1:])
+    if "--destination" in _argv:
+        # batch mode: FSeamerFile.py --destination <folder> --mock <headers...> [--spy <headers...>] [--force <bool>]
+        #             [--jobs <number of processes, 0 for one per CPU>] [--stamp <file touched once generated>]
+        _opts = _parseBatchArguments(_argv)
+        _force = _cmakeBool((_opts["--force"] or ["True"])[0])
+        generateFSeamFiles(_opts["--mock"], _opts["--destination"][0], _force, _opts["--spy"],
+                           int((_opts["--jobs"] or ["0"])[0]), (_opts["--stamp"] or [None])[0])
+        sys.exit(0)
+    _args = [a for a in _argv if not a.startswith("--")]
+    _spy = "--spy" in _argv
     if len(_args) < 2:
         raise NameError("Error missing argument for generation")
     _forceGeneration = True
     if len(_args) > 2:
-        _forceGeneration = _args[2]
-    generateFSeamFile(_args[0], _args[1], _forceGeneration)
+        _forceGeneration = _cmakeBool(_args[2])
+    generateFSeamFile(_args[0], _args[1], _forceGeneration, _spy)
@@ -4,13 +4,27 @@ set(FSEAM_GENERATOR_DESTINATION ${CMAKE_CURRENT_BINARY_DIR})
 
 option(FSEAM_FORCE_GENERATION "Force the generation of the file " ON)
 option(FSEAM_CLEANUP_DATA "Cleanup the data file  " OFF)
+set(FSEAM_GENERATOR_JOBS 0 CACHE STRING "Number of processes generating the mocks of a test target (0 for one per CPU)")
 
 option(FSEAM_USE_CATCH2 "fseam catch2 usage" ON)
 option(FSEAM_USE_GTEST "fseam catch2 usage" OFF)
+option(FSEAM_USE_USDT "fseam USDT probes (sys/sdt.h) at entry and exit of the generated mock methods" OFF)
 
 if (NOT FSEAM_GENERATOR_COMMMAND)
     set(FSEAM_GENERATOR_COMMMAND FSeamerFile.py)
 endif ()
+if (NOT FSEAM_SPY_COMMAND)
+    set(FSEAM_SPY_COMMAND FSeamSpy.py)
+endif ()
+
+# Directory of the seams shipped with FSeam (source tree layout first, then installed layout)
+if (NOT FSEAM_SEAMS_DIRECTORY)
+    if (EXISTS ${CMAKE_CURRENT_LIST_DIR}/../FSeam/seams)
+        set(FSEAM_SEAMS_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}/../FSeam/seams)
+    else ()
+        set(FSEAM_SEAMS_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}/../../include/FSeam/seams)
+    endif ()
+endif ()
 
 if (FSEAM_USE_CATCH2)
     find_package(Catch2 REQUIRED)
@@ -20,6 +34,14 @@ elseif(FSEAM_USE_GTEST)
     include(GoogleTest)
 endif ()
 
+if (FSEAM_USE_USDT)
+    include(CheckIncludeFileCXX)
+    check_include_file_cxx(sys/sdt.h FSEAM_HAS_SDT_HEADER)
+    if (NOT FSEAM_HAS_SDT_HEADER)
+        message(FATAL_ERROR "FSEAM_USE_USDT requires sys/sdt.h (systemtap sdt development package)")
+    endif ()
+endif ()
+
 include(CTest)
 
 ## ============ NOT CLIENT FACING ====================
@@ -30,36 +52,130 @@ include(CTest)
 function (setup_FSeam_test)
 
 #    message(WARNING "BEFORE Source compiled ${FSEAM_TEST_SRC}")
+    set(FSEAM_GENERATED_OUTPUTS "")
     foreach (fileToMockPath ${ADDFSEAMTESTS_TO_MOCK})
         get_filename_component(FSEAM_GENERATED_BASENAME ${fileToMockPath} NAME_WE)
         list(FILTER FSEAM_TEST_SRC EXCLUDE REGEX .*${FSEAM_GENERATED_BASENAME}.cpp)
-        message(STATUS "add custom command for ${ADDFSEAMTESTS_DESTINATION_TARGET} with fileToMock ${fileToMockPath}
-with command : ${PYTHON_EXECUTABLE} ${FSEAM_GENERATOR_COMMMAND} ${fileToMockPath} ${FSEAM_GENERATOR_DESTINATION}")
+        list(APPEND FSEAM_GENERATED_OUTPUTS ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.cc)
+        set(FSEAM_TEST_SRC ${FSEAM_TEST_SRC}
+                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.cc)
+    endforeach()
+    foreach (fileToSpyPath ${ADDFSEAMTESTS_TO_SPY})
+        get_filename_component(FSEAM_GENERATED_BASENAME ${fileToSpyPath} NAME_WE)
+        set(FSEAM_SPY_ORIGINAL_SRC ${FSEAM_TEST_SRC})
+        list(FILTER FSEAM_SPY_ORIGINAL_SRC INCLUDE REGEX .*${FSEAM_GENERATED_BASENAME}.cpp)
+        list(FILTER FSEAM_TEST_SRC EXCLUDE REGEX .*${FSEAM_GENERATED_BASENAME}.cpp)
+        list(APPEND FSEAM_GENERATED_OUTPUTS
+                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.spy.cc
+                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.forward.cc)
+
+        set(FSEAM_SPY_WRAPPER_SRC ${FSEAM_SPY_WRAPPER_SRC}
+                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.spy.cc)
+        set(FSEAM_SPY_REAL_SRC ${FSEAM_SPY_REAL_SRC} ${FSEAM_SPY_ORIGINAL_SRC}
+                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.forward.cc)
+    endforeach()
+
+    # All the headers of the target are generated by a single generator run (batch mode), the files shared by the mocks
+    # (FSeamMockData.hpp, FSeamSpecialization.cpp) are then updated once. The headers are given through a response file.
+    # The generator only rewrites the files whose content changed, the output of the command is a stamp file (touched
+    # by the generator) so an unchanged mock keeps its time and isn't recompiled.
+    if (FSEAM_GENERATED_OUTPUTS)
+        set(FSEAM_RESPONSE_FILE ${FSEAM_GENERATOR_DESTINATION}/${ADDFSEAMTESTS_DESTINATION_TARGET}.fseam.rsp)
+        set(FSEAM_STAMP_FILE ${FSEAM_GENERATOR_DESTINATION}/${ADDFSEAMTESTS_DESTINATION_TARGET}.fseam.stamp)
+        set(FSEAM_RESPONSE_CONTENT --destination ${FSEAM_GENERATOR_DESTINATION} --force ${FSEAM_FORCE_GENERATION}
+                --jobs ${FSEAM_GENERATOR_JOBS} --stamp ${FSEAM_STAMP_FILE})
+        if (ADDFSEAMTESTS_TO_MOCK)
+            list(APPEND FSEAM_RESPONSE_CONTENT --mock ${ADDFSEAMTESTS_TO_MOCK})
+        endif ()
+        if (ADDFSEAMTESTS_TO_SPY)
+            list(APPEND FSEAM_RESPONSE_CONTENT --spy ${ADDFSEAMTESTS_TO_SPY})
+        endif ()
+        string(REPLACE ";" "\n" FSEAM_RESPONSE_CONTENT "${FSEAM_RESPONSE_CONTENT}")
+        file(GENERATE OUTPUT ${FSEAM_RESPONSE_FILE} CONTENT "${FSEAM_RESPONSE_CONTENT}\n")
+        message(STATUS "add custom command for ${ADDFSEAMTESTS_DESTINATION_TARGET} with command : ${FSEAM_GENERATOR_COMMMAND} @${FSEAM_RESPONSE_FILE}")
+
         add_custom_command(
             COMMAND
                 ${FSEAM_GENERATOR_COMMMAND}
                 ARGS
-                    ${fileToMockPath}
-                    ${FSEAM_GENERATOR_DESTINATION}
+                    @${FSEAM_RESPONSE_FILE}
             OUTPUT
-                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.cc
+                ${FSEAM_STAMP_FILE}
+            BYPRODUCTS
+                ${FSEAM_GENERATED_OUTPUTS}
             DEPENDS
-                ${fileToMockPath}
+                ${ADDFSEAMTESTS_TO_MOCK}
+                ${ADDFSEAMTESTS_TO_SPY}
+                ${FSEAM_RESPONSE_FILE}
             USES_TERMINAL
-            COMMENT "Generating FSEAM code for ${fileToMockPath}")
+            COMMENT "Generating FSEAM code for ${ADDFSEAMTESTS_DESTINATION_TARGET}")
 
-        add_custom_target(${ADDFSEAMTESTS_DESTINATION_TARGET}${FSEAM_GENERATED_BASENAME}Run ALL
+        add_custom_target(${ADDFSEAMTESTS_DESTINATION_TARGET}FSeamRun ALL
                 DEPENDS
-                    ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.cc)
-
-        set(FSEAM_TEST_SRC ${FSEAM_TEST_SRC}
-                ${FSEAM_GENERATOR_DESTINATION}/${FSEAM_GENERATED_BASENAME}.fseam.cc)
-
+                    ${FSEAM_STAMP_FILE})
+    endif ()
+    foreach (seam ${ADDFSEAMTESTS_SEAMS})
+        if (NOT EXISTS ${FSEAM_SEAMS_DIRECTORY}/${seam}.cc)
+            message(FATAL_ERROR "Unknown FSeam seam ${seam} (no ${seam}.cc in ${FSEAM_SEAMS_DIRECTORY})")
+        endif ()
+        set(FSEAM_TEST_SRC ${FSEAM_TEST_SRC} ${FSEAM_SEAMS_DIRECTORY}/${seam}.cc)
     endforeach()
 #    message(WARNING "AFTER Source compiled ${FSEAM_TEST_SRC}")
     set(FSEAM_TEST_SRC ${FSEAM_TEST_SRC} PARENT_SCOPE)
+    set(FSEAM_SPY_WRAPPER_SRC ${FSEAM_SPY_WRAPPER_SRC} PARENT_SCOPE)
+    set(FSEAM_SPY_REAL_SRC ${FSEAM_SPY_REAL_SRC} PARENT_SCOPE)
 endfunction (setup_FSeam_test)
 
+## ============ NOT CLIENT FACING ====================
+## Function used internally in order to build the spied code (TO_SPY) of a test :
+## - the spy wrappers are compiled as an object library
+## - the original implementation and the forwarders are linked into a relocatable object in which the spied methods
+##   are renamed (see Generator/FSeamSpy.py), the forwarders calling the renamed original implementation
+## create a cmake variable FSEAM_SPY_OBJECTS containing the objects to add to the test
+##
+function (setup_FSeam_spy)
+    set(FSEAM_SPY_TARGET ${ADDFSEAMTESTS_DESTINATION_TARGET}FSeamSpy)
+    set(FSEAM_SPY_OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/${FSEAM_SPY_TARGET}.o)
+
+    add_library(${FSEAM_SPY_TARGET} OBJECT ${FSEAM_SPY_WRAPPER_SRC})
+    add_library(${FSEAM_SPY_TARGET}Real OBJECT ${FSEAM_SPY_REAL_SRC})
+    foreach (target ${FSEAM_SPY_TARGET} ${FSEAM_SPY_TARGET}Real)
+        set_target_properties(${target} PROPERTIES CXX_STANDARD 17 POSITION_INDEPENDENT_CODE ON)
+        add_dependencies(${target} ${ADDFSEAMTESTS_DESTINATION_TARGET}FSeamRun)
+        target_include_directories(${target}
+                PUBLIC
+                    ${FSEAM_TEST_INCLUDES}
+                    ${FSEAM_GENERATOR_DESTINATION}
+                    ${CMAKE_CURRENT_SOURCE_DIR}/../FSeam)
+        if (FSEAM_USE_CATCH2)
+            target_compile_definitions(${target} PRIVATE FSEAM_USE_CATCH2)
+            target_link_libraries(${target} FSeam Catch2::Catch2)
+        endif ()
+        if (FSEAM_USE_USDT)
+            target_compile_definitions(${target} PRIVATE FSEAM_USE_USDT)
+        endif ()
+    endforeach ()
+
+    add_custom_command(
+        COMMAND
+            ${FSEAM_SPY_COMMAND}
+            ARGS
+                --output ${FSEAM_SPY_OUTPUT}
+                --nm ${CMAKE_NM} --ld ${CMAKE_LINKER} --objcopy ${CMAKE_OBJCOPY}
+                --wrappers $<TARGET_OBJECTS:${FSEAM_SPY_TARGET}>
+                --objects $<TARGET_OBJECTS:${FSEAM_SPY_TARGET}Real>
+        OUTPUT
+            ${FSEAM_SPY_OUTPUT}
+        DEPENDS
+            ${FSEAM_SPY_TARGET} ${FSEAM_SPY_TARGET}Real
+            $<TARGET_OBJECTS:${FSEAM_SPY_TARGET}> $<TARGET_OBJECTS:${FSEAM_SPY_TARGET}Real>
+        COMMAND_EXPAND_LISTS
+        COMMENT "Linking FSEAM spied code for ${ADDFSEAMTESTS_DESTINATION_TARGET}")
+    set_source_files_properties(${FSEAM_SPY_OUTPUT} PROPERTIES EXTERNAL_OBJECT TRUE GENERATED TRUE)
+
+    set(FSEAM_SPY_OBJECTS $<TARGET_OBJECTS:${FSEAM_SPY_TARGET}> ${FSEAM_SPY_OUTPUT} PARENT_SCOPE)
+endfunction (setup_FSeam_spy)
+
 ## ============ CLIENT FACING ====================
 ## Function to call in order to generate a test executable from the generated FSeam mock and the provided test source
 ##
@@ -77,11 +193,14 @@ endfunction (setup_FSeam_test)
 ## 
 ## optional 
 ## arg MAIN_FILE           : file containing the main (if any), this file will be removed from the compilation of the test
+## arg SEAMS               : seams shipped with FSeam to link into the test (clock, alloc, fileio, socket, syscall, lock)
+## arg TO_SPY              : files to spy for this specific given test, the calls are recorded as for a mock but
+##                           forwarded to the original implementation (the matching .cpp found in the source)
 ##
 function(addFSeamTests)
 
     set(oneValueArgs DESTINATION_TARGET TARGET_AS_SOURCE MAIN_FILE)
-    set(multiValueArgs TO_MOCK TST_SRC FILES_AS_SOURCE FOLDER_INCLUDES)
+    set(multiValueArgs TO_MOCK TO_SPY TST_SRC FILES_AS_SOURCE FOLDER_INCLUDES SEAMS)
     cmake_parse_arguments(ADDFSEAMTESTS "" "${oneValueArgs}" "${multiValueArgs}"  ${ARGN} )
 
     # Check arguments
@@ -98,19 +217,30 @@ function(addFSeamTests)
         list(FILTER FSEAM_TEST_SRC EXCLUDE REGEX .*${ADDFSEAMTESTS_MAIN_FILE})
     endif ()
     setup_FSeam_test()
+    if (FSEAM_SPY_WRAPPER_SRC)
+        setup_FSeam_spy()
+    endif ()
 
     # Create testing target
     execute_process(COMMAND touch ${FSEAM_GENERATOR_DESTINATION}/FSeamMockData.hpp ${FSEAM_GENERATOR_DESTINATION}/FSeamSpecialization.cpp)
-    add_executable(${ADDFSEAMTESTS_DESTINATION_TARGET} ${FSEAM_TEST_SRC} ${ADDFSEAMTESTS_TST_SRC}
+    add_executable(${ADDFSEAMTESTS_DESTINATION_TARGET} ${FSEAM_TEST_SRC} ${ADDFSEAMTESTS_TST_SRC} ${FSEAM_SPY_OBJECTS}
             ${FSEAM_GENERATOR_DESTINATION}/FSeamMockData.hpp
             ${FSEAM_GENERATOR_DESTINATION}/FSeamSpecialization.cpp)
     set_target_properties(${ADDFSEAMTESTS_DESTINATION_TARGET} PROPERTIES CXX_STANDARD 17)
+    # the generated sources are byproducts of the generation (its output being the stamp file): the test has to depend
+    # on the generation target to get them generated before being compiled
+    if (TARGET ${ADDFSEAMTESTS_DESTINATION_TARGET}FSeamRun)
+        add_dependencies(${ADDFSEAMTESTS_DESTINATION_TARGET} ${ADDFSEAMTESTS_DESTINATION_TARGET}FSeamRun)
+    endif ()
     target_include_directories(${ADDFSEAMTESTS_DESTINATION_TARGET}
             PUBLIC
                 ${FSEAM_TEST_INCLUDES}
                 ${FSEAM_GENERATOR_DESTINATION}
                 ${CMAKE_CURRENT_SOURCE_DIR}/../FSeam)
 
+    if (FSEAM_USE_USDT)
+        target_compile_definitions(${ADDFSEAMTESTS_DESTINATION_TARGET} PRIVATE FSEAM_USE_USDT)
+    endif ()
     if (FSEAM_USE_CATCH2)
         target_compile_definitions(${ADDFSEAMTESTS_DESTINATION_TARGET} PRIVATE FSEAM_USE_CATCH2)
         target_link_libraries(${ADDFSEAMTESTS_DESTINATION_TARGET} FSeam Catch2::Catch2)
@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <FSeam.hpp>
+
+namespace {
+    int noAllocation(const std::vector<int> &values) {
+        int sum = 0;
+        for (int value : values)
+            sum += value;
+        return sum;
+    }
+}
+
+TEST_CASE("Test allocation seam") {
+    std::vector<int> values(16, 1);
+
+    SECTION("No allocation") {
+        FSeam::AllocationScope scope("hot path");
+        int sum = noAllocation(values);
+        FSeam::AllocationScope::Counters counters = scope.counters();
+        CHECK(16 == sum);
+        CHECK(0 == counters.allocations);
+        CHECK(FSeam::verifyAllocations(scope, FSeam::AtMost(0)));
+
+    } // End section : No allocation
+
+    SECTION("operator new and delete") {
+        FSeam::AllocationScope::Counters counters;
+        {
+            FSeam::AllocationScope scope;
+            {
+                std::vector<int> allocated(100);
+                auto unique = std::make_unique<long>(42);
+            }
+            counters = scope.counters();
+        }
+        CHECK(2 == counters.allocations);
+        CHECK(2 == counters.deallocations);
+        CHECK(100 * sizeof(int) + sizeof(long) == counters.bytes);
+        CHECK(0 == counters.liveBytes);
+        CHECK(counters.peakLiveBytes >= static_cast<std::int64_t>(100 * sizeof(int) + sizeof(long)));
+
+    } // End section : operator new and delete
+
+    SECTION("malloc family") {
+        FSeam::AllocationScope::Counters counters;
+        {
+            FSeam::AllocationScope scope;
+            void *ptr = std::malloc(64);
+            ptr = std::realloc(ptr, 128);
+            void *zeroed = std::calloc(4, 8);
+            std::free(ptr);
+            std::free(zeroed);
+            counters = scope.counters();
+        }
+        CHECK(3 == counters.allocations);
+        CHECK(3 == counters.deallocations);
+        CHECK(64 + 128 + 32 == counters.bytes);
+        CHECK(0 == counters.liveBytes);
+
+    } // End section : malloc family
+
+    SECTION("Nested scopes and verify") {
+        FSeam::AllocationScope outer("outer");
+        std::size_t innerAllocations = 0;
+        {
+            FSeam::AllocationScope inner("inner");
+            auto unique = std::make_unique<int>(1);
+            innerAllocations = inner.counters().allocations;
+        }
+        auto unique = std::make_unique<int>(2);
+        std::size_t outerAllocations = outer.counters().allocations;
+        CHECK(1 == innerAllocations);
+        CHECK(2 == outerAllocations);
+        CHECK_FALSE(FSeam::verifyAllocations(outer, FSeam::AtMost(0), false));
+        CHECK(FSeam::verifyAllocations(outer, FSeam::AtLeast(2)));
+
+    } // End section : Nested scopes and verify
+
+    SECTION("Per thread counters") {
+        std::size_t before = FSeam::AllocationScope::thread().allocations;
+        auto unique = std::make_unique<int>(1);
+        CHECK(before + 1 == FSeam::AllocationScope::thread().allocations);
+
+    } // End section : Per thread counters
+
+} // End TestCase : Test allocation seam
@@ -0,0 +1,589 @@
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+#include <condition_variable>
+#include <thread>
+
+namespace {
+    struct Message {
+        std::string header;
+        std::vector<int> body;
+    };
+}
+
+template <> struct FSeam::PayloadSize<Message> {
+    static std::size_t size(const Message &m) { return m.header.size() + m.body.size() * sizeof(int); }
+};
+
+TEST_CASE("Test redundant calls report") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    FSeam::report::enableRedundantCalls();
+
+    SECTION("Same arguments") {
+        testingClass.execute();
+        testingClass.execute();
+        testingClass.execute();
+
+        FSeam::report::RedundantCall redundant = fseamMock->redundantCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(3 == redundant.calls);
+        CHECK(1 == redundant.distinct);
+        CHECK(Approx(2. / 3.) == redundant.duplicateRatio());
+        REQUIRE(1 == redundant.topTuples.size());
+        CHECK(std::string("(42, 4242)") == redundant.topTuples.front().first);
+        CHECK(3 == redundant.topTuples.front().second);
+
+        CHECK_FALSE(FSeam::report::redundantCalls(0.5).empty());
+        CHECK_FALSE(FSeam::report::verifyRedundantCalls(0.5, false));
+        CHECK(FSeam::report::verifyRedundantCalls(0.7));
+
+    } // End section : Same arguments
+
+    SECTION("Different arguments") {
+        testingClass.getDepGettable().checkSimpleInputVariable(1, "FyS");
+        testingClass.getDepGettable().checkSimpleInputVariable(2, "FyS");
+        testingClass.getDepGettable().checkSimpleInputVariable(1, "Balland");
+
+        FSeam::report::RedundantCall redundant = fseamMock->redundantCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(3 == redundant.calls);
+        CHECK(3 == redundant.distinct);
+        CHECK(redundant.topTuples.empty());
+        CHECK(FSeam::report::verifyRedundantCalls(0.));
+
+    } // End section : Different arguments
+
+    SECTION("Non hashable arguments") {
+        source::StructTest testStruct {42, 1337, "FyS"};
+        testingClass.getDepGettable().checkCustomStructInputVariableRef(testStruct);
+        testingClass.getDepGettable().checkCustomStructInputVariableRef(testStruct);
+
+        FSeam::report::RedundantCall redundant = fseamMock->redundantCalls(FSeam::DependencyGettable::checkCustomStructInputVariableRef::NAME);
+        CHECK(0 == redundant.calls);
+        CHECK(2 == redundant.unhashedCalls);
+
+    } // End section : Non hashable arguments
+
+    FSeam::report::enableRedundantCalls(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test redundant calls report
+
+TEST_CASE("Test chatty calls report") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    FSeam::report::enableChattyCalls();
+
+    SECTION("Calls in a loop") {
+        for (int i = 0; i < 5; ++i)
+            testingClass.getDepGettable().checkSimpleInputVariable(i, "FyS");
+        testingClass.getDepGettable().checkCalled();
+        for (int i = 0; i < 3; ++i)
+            testingClass.getDepGettable().checkSimpleInputVariable(i, "FyS");
+
+        FSeam::report::ChattyCall chatty = fseamMock->chattyCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(8 == chatty.calls);
+        CHECK(2 == chatty.runs);
+        CHECK(5 == chatty.maxRun);
+        CHECK(1 == chatty.runLengths[5]);
+        CHECK(1 == chatty.runLengths[3]);
+
+        CHECK_FALSE(fseamMock->verifyBatched<FSeam::DependencyGettable::checkSimpleInputVariable>(4, false));
+        CHECK(fseamMock->verifyBatched<FSeam::DependencyGettable::checkSimpleInputVariable>(5));
+        CHECK(fseamMock->verifyBatched<FSeam::DependencyGettable::checkCalled>(1));
+
+        auto reports = FSeam::report::chattyCalls();
+        REQUIRE(1 == reports.size());
+        CHECK(reports.front().key == chatty.key);
+
+    } // End section : Calls in a loop
+
+    SECTION("Interleaved calls") {
+        testingClass.execute();
+        testingClass.execute();
+        CHECK(fseamMock->verifyBatched<FSeam::DependencyGettable::checkSimpleInputVariable>(1));
+        CHECK(FSeam::report::chattyCalls().empty());
+
+    } // End section : Interleaved calls
+
+    SECTION("Identical arguments") {
+        for (int i = 0; i < 4; ++i)
+            testingClass.getDepGettable().checkSimpleInputVariable(42, "FyS");
+
+        FSeam::report::ChattyCall chatty = fseamMock->chattyCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(4 == chatty.calls);
+        CHECK(0 == chatty.runs);
+        CHECK(0 == chatty.maxRun);
+        CHECK(1 == chatty.identicalRuns[4]);
+        CHECK(fseamMock->verifyBatched<FSeam::DependencyGettable::checkSimpleInputVariable>(1));
+
+        testingClass.getDepGettable().checkSimpleInputVariable(43, "FyS");
+        chatty = fseamMock->chattyCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(5 == chatty.maxRun);
+        CHECK(chatty.identicalRuns.empty());
+
+    } // End section : Identical arguments
+
+    FSeam::report::enableChattyCalls(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test chatty calls report
+
+TEST_CASE("Test cost budget") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    fseamMock->setCost<FSeam::DependencyGettable::checkCalled>(1.);
+    fseamMock->setCost<FSeam::DependencyGettable::checkSimpleInputVariable>([](void *methodCallData) {
+        return static_cast<double>(static_cast<FSeam::DependencyGettableData *>(methodCallData)->checkSimpleInputVariable_easy_ParamValue->size());
+    });
+
+    SECTION("Cost accounted in scope") {
+        FSeam::Scope scope("execute");
+        testingClass.execute();
+        testingClass.execute();
+
+        CHECK(Approx(10.) == scope.cost()); // 2 * (1 + size of "4242")
+        CHECK(2 == scope.costs().at("DependencyGettablecheckCalled").calls);
+        CHECK(Approx(8.) == scope.costs().at("DependencyGettablecheckSimpleInputVariable").cost);
+        CHECK(FSeam::verifyCostBudget(scope, 10.));
+        CHECK_FALSE(FSeam::verifyCostBudget(scope, 9.5, false));
+
+    } // End section : Cost accounted in scope
+
+    SECTION("Nested scopes") {
+        FSeam::Scope outer("outer");
+        testingClass.execute();
+        {
+            FSeam::Scope inner("inner");
+            testingClass.getDepGettable().checkCalled();
+            CHECK(Approx(1.) == inner.cost());
+        }
+        testingClass.getDepGettable().checkCalled();
+        CHECK(Approx(7.) == outer.cost());
+
+    } // End section : Nested scopes
+
+    SECTION("No cost outside of scope") {
+        testingClass.execute();
+        FSeam::Scope scope;
+        CHECK(Approx(0.) == scope.cost());
+        CHECK(FSeam::verifyCostBudget(scope, 0.));
+
+    } // End section : No cost outside of scope
+
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test cost budget
+
+TEST_CASE("Test transitions report") {
+    using namespace std::chrono_literals;
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    FSeam::report::enableTransitions();
+
+    SECTION("Transitions between mocked calls") {
+        testingClass.execute();
+        testingClass.execute();
+
+        std::vector<FSeam::report::Transition> transitions = FSeam::report::transitions();
+        std::size_t calls = 0;
+        for (const auto &transition : transitions)
+            calls += transition.calls;
+        CHECK(11 == calls);
+        FSeam::report::Transition loop = FSeam::report::transition("DependencyGettablecheckSimpleReturnValue", "DependencyNonGettablecheckCalled");
+        CHECK(1 == loop.calls);
+        CHECK(0 == FSeam::report::transition("DependencyGettablecheckCalled", "DependencyNonGettablecheckCalled").calls);
+        CHECK(6 == transitions.size());
+        CHECK(5 == FSeam::report::transitions(2).size());
+
+    } // End section : Transitions between mocked calls
+
+    SECTION("Time spent in the code under test") {
+        fseamMock->dupeMethod(FSeam::DependencyGettable::checkCalled::NAME, [](void *) { std::this_thread::sleep_for(20ms); });
+        auto start = std::chrono::steady_clock::now();
+        testingClass.getDepGettable().checkCalled();
+        std::this_thread::sleep_for(2ms);
+        testingClass.getDepGettable().checkSimpleReturnValue();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        FSeam::report::Transition transition = FSeam::report::transition("DependencyGettablecheckCalled", "DependencyGettablecheckSimpleReturnValue");
+        REQUIRE(1 == transition.calls);
+        CHECK(transition.min >= 2ms);
+        CHECK(transition.max <= elapsed - 20ms); // the time spent into the mocked call isn't part of the transition
+        CHECK(transition.percentile(0.5) == transition.max);
+        CHECK(1 == transition.buckets.size());
+        CHECK(FSeam::report::verifyTransitions(1s));
+        CHECK_FALSE(FSeam::report::verifyTransitions(1ms, 1., false));
+
+    } // End section : Time spent in the code under test
+
+    FSeam::report::enableTransitions(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test transitions report
+
+TEST_CASE("Test call sites report") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    FSeam::report::enableCallSites();
+
+    SECTION("Calls per call site") {
+        for (int i = 0; i < 3; ++i)
+            dependency.checkCalled();
+        dependency.checkCalled();
+        dependency.checkSimpleReturnValue();
+
+        std::vector<FSeam::report::CallSite> callSites = FSeam::report::callSites();
+        REQUIRE(3 == callSites.size());
+        CHECK("DependencyGettablecheckCalled" == callSites.front().key);
+        CHECK(3 == callSites.front().calls);
+        CHECK(callSites.front().address != callSites[1].address);
+        CHECK(callSites.front().module.find("testFSeam") != std::string::npos);
+        CHECK(0 != callSites.front().offset);
+        CHECK(1 == FSeam::report::callSites(2).size());
+
+    } // End section : Calls per call site
+
+    SECTION("Call sites file") {
+        testingClass.execute();
+        std::string path = "fseam-call-sites.tsv";
+        REQUIRE(FSeam::report::writeCallSites(path));
+
+        std::ifstream file(path);
+        std::string line;
+        std::size_t lines = 0;
+        while (std::getline(file, line))
+            ++lines;
+        CHECK(FSeam::report::callSites().size() == lines);
+        CHECK(lines > 0);
+        std::remove(path.c_str());
+
+    } // End section : Call sites file
+
+    SECTION("Disabled by default") {
+        FSeam::report::enableCallSites(false);
+        dependency.checkCalled();
+        CHECK(FSeam::report::callSites().empty());
+
+    } // End section : Disabled by default
+
+    FSeam::report::enableCallSites(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test call sites report
+
+TEST_CASE("Test argument sketches") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    auto fseamMock = FSeam::get(&dependency);
+    FSeam::report::enableSketches();
+
+    SECTION("Distinct values and distribution") {
+        for (int i = 0; i < 2000; ++i)
+            dependency.checkSimpleInputVariable(i % 1000, i % 4 ? "FyS" : "Balland");
+
+        FSeam::report::ArgumentSketches sketches = fseamMock->sketches(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(2000 == sketches.calls);
+        CHECK(Approx(1000.).epsilon(0.1) == sketches.distinctTuples.estimate());
+        REQUIRE(2 == sketches.parameters.size());
+
+        const FSeam::report::ParameterSketch &number = sketches.parameters.front();
+        CHECK(Approx(1000.).epsilon(0.1) == number.distinct.estimate());
+        REQUIRE(number.distribution.has_value());
+        CHECK(0. == number.distribution->min);
+        CHECK(999. == number.distribution->max);
+        CHECK(Approx(499.5) == number.distribution->mean());
+        CHECK(2 == number.distribution->histogram().at(1.));
+        CHECK(512 == number.distribution->histogram().at(512.));
+
+        const FSeam::report::ParameterSketch &name = sketches.parameters.back();
+        CHECK(Approx(2.).epsilon(0.01) == name.distinct.estimate());
+        CHECK_FALSE(name.distribution.has_value());
+        auto top = name.topValues.top(1);
+        REQUIRE(1 == top.size());
+        CHECK("FyS" == top.front().value);
+        CHECK(1500 == top.front().count);
+        CHECK(0 == top.front().error);
+
+        REQUIRE(1 == FSeam::report::sketches().size());
+        CHECK("DependencyGettablecheckSimpleInputVariable" == FSeam::report::sketches().front().key);
+
+    } // End section : Distinct values and distribution
+
+    SECTION("Heavy hitters in fixed memory") {
+        for (int i = 0; i < 1000; ++i) {
+            dependency.checkSimpleInputVariable(7, "FyS");
+            dependency.checkSimpleInputVariable(1000 + i, "FyS");
+        }
+        FSeam::report::ArgumentSketches sketches = fseamMock->sketches(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        auto top = sketches.parameters.front().topValues.top();
+        REQUIRE(FSeam::report::HeavyHitters::CAPACITY >= top.size());
+        CHECK("7" == top.front().value);
+        CHECK(1000 <= top.front().count);
+
+    } // End section : Heavy hitters in fixed memory
+
+    SECTION("Non hashable arguments") {
+        source::StructTest testStruct {42, 1337, "FyS"};
+        dependency.checkCustomStructInputVariableRef(testStruct);
+
+        FSeam::report::ArgumentSketches sketches = fseamMock->sketches(FSeam::DependencyGettable::checkCustomStructInputVariableRef::NAME);
+        CHECK(1 == sketches.calls);
+        REQUIRE(1 == sketches.parameters.size());
+        CHECK(1 == sketches.parameters.front().unhashed);
+        CHECK(sketches.parameters.front().topValues.top().empty());
+
+    } // End section : Non hashable arguments
+
+    SECTION("Disabled by default") {
+        FSeam::report::enableSketches(false);
+        dependency.checkCalled();
+        CHECK(FSeam::report::sketches().empty());
+
+    } // End section : Disabled by default
+
+    FSeam::report::enableSketches(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test argument sketches
+
+TEST_CASE("Test cache simulation") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    auto fseamMock = FSeam::get(&dependency);
+    FSeam::report::enableCacheSimulation();
+
+    SECTION("Hit ratio curve") {
+        for (int i = 0; i < 1000; ++i) {
+            dependency.checkSimpleInputVariable(i % 10, "hot");
+            dependency.checkSimpleInputVariable(1000 + i, "scan");
+        }
+        FSeam::report::CacheSimulation simulation = fseamMock->simulateCache<FSeam::DependencyGettable::checkSimpleInputVariable>(
+                FSeam::report::ALL_POLICIES, {16, 2048});
+        CHECK("DependencyGettablecheckSimpleInputVariable" == simulation.key);
+        CHECK(2000 == simulation.calls);
+        CHECK(1010 == simulation.distinct);
+        REQUIRE(3 == simulation.curves.size());
+
+        const FSeam::report::CacheCurve *lru = simulation.curve(FSeam::report::LRU);
+        REQUIRE(lru != nullptr);
+        REQUIRE(2 == lru->points.size());
+        CHECK(16 == lru->points.front().capacity);
+        CHECK(2000 == lru->points.front().lookups);
+        CHECK(0 == lru->points.front().hits);
+        CHECK(990 == lru->points.back().hits);
+        CHECK(990 == simulation.curve(FSeam::report::LFU)->points.back().hits);
+        CHECK(990 == simulation.curve(FSeam::report::TINY_LFU)->points.back().hits);
+
+        // the one-off scan keys are not admitted by TinyLFU, the hot keys stay in cache
+        CHECK(simulation.curve(FSeam::report::TINY_LFU)->points.front().hitRatio() > 0.4);
+
+    } // End section : Hit ratio curve
+
+    SECTION("Selected policies") {
+        dependency.checkSimpleInputVariable(1, "FyS");
+        dependency.checkSimpleInputVariable(1, "FyS");
+
+        FSeam::report::CacheSimulation simulation = fseamMock->simulateCache<FSeam::DependencyGettable::checkSimpleInputVariable>(
+                FSeam::report::LRU | FSeam::report::LFU, {0, 1});
+        REQUIRE(2 == simulation.curves.size());
+        CHECK(nullptr == simulation.curve(FSeam::report::TINY_LFU));
+        CHECK(0 == simulation.curve(FSeam::report::LRU)->points.front().hits);
+        CHECK(Approx(0.5) == simulation.curve(FSeam::report::LFU)->points.back().hitRatio());
+
+    } // End section : Selected policies
+
+    SECTION("Uncacheable arguments") {
+        source::StructTest testStruct {42, 1337, "FyS"};
+        dependency.checkCustomStructInputVariableRef(testStruct);
+
+        FSeam::report::CacheSimulation simulation = fseamMock->simulateCache<FSeam::DependencyGettable::checkCustomStructInputVariableRef>(
+                FSeam::report::LRU, {1});
+        CHECK(1 == simulation.calls);
+        CHECK(1 == simulation.uncacheable);
+        CHECK(0 == simulation.curve(FSeam::report::LRU)->points.front().lookups);
+
+    } // End section : Uncacheable arguments
+
+    SECTION("Disabled by default") {
+        FSeam::report::enableCacheSimulation(false);
+        dependency.checkSimpleInputVariable(1, "FyS");
+        CHECK(0 == fseamMock->simulateCache<FSeam::DependencyGettable::checkSimpleInputVariable>(FSeam::report::LRU, {1}).calls);
+
+    } // End section : Disabled by default
+
+    FSeam::report::enableCacheSimulation(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test cache simulation
+
+TEST_CASE("Test payload volume") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    auto fseamMock = FSeam::get(&dependency);
+    FSeam::report::enablePayload();
+
+    SECTION("Bytes in and out per method") {
+        dependency.checkSimpleInputVariable(42, "FyS");
+        dependency.checkSimpleInputVariable(42, "Balland");
+        for (int i = 0; i < 3; ++i)
+            dependency.checkSimpleReturnValue();
+        dependency.checkCustomStructReturnValue();
+
+        FSeam::report::Payload input = fseamMock->payload(FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(2 == input.calls);
+        CHECK(2 * sizeof(int) + 10 == input.bytesIn);
+        CHECK(0 == input.bytesOut);
+        CHECK(sizeof(int) + 3 == input.in.min);
+        CHECK(sizeof(int) + 7 == input.in.max);
+
+        FSeam::report::Payload output = fseamMock->payload(FSeam::DependencyGettable::checkSimpleReturnValue::NAME);
+        CHECK(3 == output.calls);
+        CHECK(0 == output.bytesIn);
+        CHECK(3 * sizeof(int) == output.bytesOut);
+        CHECK(3 == output.out.count);
+
+        std::vector<FSeam::report::Payload> payloads = FSeam::report::payloads();
+        REQUIRE(3 == payloads.size());
+        CHECK("DependencyGettablecheckCustomStructReturnValue" == payloads.front().key);
+        CHECK(sizeof(source::StructTest) == payloads.front().bytesOut);
+
+    } // End section : Bytes in and out per method
+
+    SECTION("Per scope") {
+        FSeam::Scope scope("payload");
+        dependency.checkSimpleInputVariable(1, "abcd");
+        {
+            FSeam::Scope nested("nested");
+            dependency.checkSimpleReturnValue();
+            CHECK(1 == nested.payload().calls);
+        }
+        CHECK(2 == scope.payload().calls);
+        CHECK(2 * sizeof(int) + 4 == scope.payload().bytes());
+        CHECK(sizeof(int) == scope.payload().bytesOut);
+        REQUIRE(2 == scope.payloads().size());
+        CHECK(sizeof(int) + 4 == scope.payloads().at("DependencyGettablecheckSimpleInputVariable").bytesIn);
+
+    } // End section : Per scope
+
+    SECTION("Size traits") {
+        CHECK(5 == FSeam::report::internal::payloadBytes(std::string("hello")));
+        CHECK(3 * sizeof(double) == FSeam::report::internal::payloadBytes(std::vector<double>(3)));
+        CHECK(sizeof(int) + 6 == FSeam::report::internal::payloadBytes(42, Message{"ab", {1}}));
+
+    } // End section : Size traits
+
+    SECTION("Disabled by default") {
+        FSeam::report::enablePayload(false);
+        dependency.checkSimpleReturnValue();
+        CHECK(FSeam::report::payloads().empty());
+
+    } // End section : Disabled by default
+
+    FSeam::report::enablePayload(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test payload volume
+
+TEST_CASE("Test concurrent calls") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    auto fseamMock = FSeam::get(&dependency);
+    FSeam::report::enableConcurrency();
+
+    SECTION("Parallel fan-out") {
+        std::mutex mutex;
+        std::condition_variable allArrived;
+        std::size_t arrived = 0;
+        fseamMock->dupeMethod(FSeam::DependencyGettable::checkCalled::NAME, [&](void *) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++arrived;
+            allArrived.notify_all();
+            allArrived.wait_for(lock, std::chrono::seconds(5), [&arrived] { return arrived == 3; });
+        });
+        std::vector<std::thread> fanOut;
+        for (int i = 0; i < 3; ++i)
+            fanOut.emplace_back([&dependency] { dependency.checkCalled(); });
+        for (auto &thread : fanOut)
+            thread.join();
+
+        FSeam::report::Concurrency concurrency = fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME);
+        CHECK(3 == concurrency.calls);
+        CHECK(3 == concurrency.maxInFlight);
+        CHECK(2 == concurrency.overlappedCalls);
+        CHECK(fseamMock->verifyConcurrent<FSeam::DependencyGettable::checkCalled>(3));
+        CHECK(fseamMock->verifyMaxInFlight<FSeam::DependencyGettable::checkCalled>(FSeam::AtMost(3)));
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 3));
+
+    } // End section : Parallel fan-out
+
+    SECTION("Fan-out across mocked instances") {
+        source::DependencyGettable other;
+        FSeam::report::enableChattyCalls();
+        std::vector<std::thread> fanOut;
+        for (int i = 0; i < 4; ++i) {
+            fanOut.emplace_back([&dependency, &other] {
+                for (int call = 0; call < 100; ++call) {
+                    dependency.checkCalled();
+                    other.checkSimpleInputVariable(call, "FyS"); // default mock, registered by the first call
+                }
+            });
+        }
+        for (auto &thread : fanOut)
+            thread.join();
+        FSeam::report::enableChattyCalls(false);
+
+        auto defaultMock = FSeam::getDefault<source::DependencyGettable>();
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 400));
+        CHECK(defaultMock->verify(FSeam::DependencyGettable::checkSimpleInputVariable::NAME, 400));
+        CHECK(400 == fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME).calls);
+        CHECK(400 == fseamMock->chattyCalls(FSeam::DependencyGettable::checkCalled::NAME).calls);
+        CHECK(400 == defaultMock->chattyCalls(FSeam::DependencyGettable::checkSimpleInputVariable::NAME).calls);
+
+    } // End section : Fan-out across mocked instances
+
+    SECTION("Throwing dupe handler") {
+        fseamMock->dupeMethod(FSeam::DependencyGettable::checkCalled::NAME, [](void *) { throw std::runtime_error("injected"); });
+        CHECK_THROWS_AS(dependency.checkCalled(), std::runtime_error);
+        CHECK(FSeam::report::internal::callEntries.empty());
+        CHECK(0 == fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME).calls);
+
+    } // End section : Throwing dupe handler
+
+    SECTION("Serial calls") {
+        for (int i = 0; i < 3; ++i)
+            dependency.checkCalled();
+
+        FSeam::report::Concurrency concurrency = fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME);
+        CHECK(3 == concurrency.calls);
+        CHECK(1 == concurrency.maxInFlight);
+        CHECK(0 == concurrency.overlappedCalls);
+        CHECK(std::chrono::nanoseconds::zero() == concurrency.concurrentTime);
+        CHECK_FALSE(fseamMock->verifyConcurrent<FSeam::DependencyGettable::checkCalled>(2, false));
+
+    } // End section : Serial calls
+
+    SECTION("Virtual time of a queueing model") {
+        using namespace std::chrono_literals;
+        FSeam::Queueing::Model model;
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10ms}, 1});
+        model.run(4, 1, [&dependency](std::size_t) { dependency.checkCalled(); });
+
+        // queued calls are in flight: issued but not completed
+        FSeam::report::Concurrency concurrency = fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME);
+        CHECK(4 == concurrency.maxInFlight);
+        CHECK(30ms == concurrency.concurrentTime);
+        CHECK_FALSE(fseamMock->verifyMaxInFlight<FSeam::DependencyGettable::checkCalled>(FSeam::AtMost(2), false));
+
+    } // End section : Virtual time of a queueing model
+
+    SECTION("Disabled by default") {
+        FSeam::report::enableConcurrency(false);
+        dependency.checkCalled();
+        CHECK(0 == fseamMock->concurrency(FSeam::DependencyGettable::checkCalled::NAME).calls);
+
+    } // End section : Disabled by default
+
+    FSeam::report::enableConcurrency(false);
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test concurrent calls
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include <thread>
+#include <FSeam.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test virtual clock seam") {
+    auto realStart = std::chrono::steady_clock::now();
+    FSeam::Clock::enable();
+
+    SECTION("sleep_for advances the clock") {
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(30s);
+        CHECK(30s == std::chrono::steady_clock::now() - start);
+
+    } // End section : sleep_for advances the clock
+
+    SECTION("sleep_until") {
+        auto deadline = std::chrono::steady_clock::now() + 2min;
+        std::this_thread::sleep_until(deadline);
+        CHECK(std::chrono::steady_clock::now() >= deadline);
+
+    } // End section : sleep_until
+
+    SECTION("advance") {
+        auto steadyStart = std::chrono::steady_clock::now();
+        auto systemStart = std::chrono::system_clock::now();
+        CHECK(steadyStart == std::chrono::steady_clock::now());
+
+        FSeam::Clock::advance(1h);
+        CHECK(1h == std::chrono::steady_clock::now() - steadyStart);
+        CHECK(1h == std::chrono::system_clock::now() - systemStart);
+
+    } // End section : advance
+
+    SECTION("queueing model clients") {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::chrono::nanoseconds> seen(3);
+        FSeam::Queueing::Model model;
+
+        FSeam::Queueing::Result result = model.run(3, 2, [&seen, start](std::size_t client) {
+            seen[client] = std::chrono::steady_clock::now() - start;
+            std::this_thread::sleep_for(5ms * (client + 1));
+        });
+        CHECK(5ms == result.latencies.front());
+        CHECK(15ms == result.latencies.back());
+        CHECK(30ms == result.duration);
+        CHECK(15ms == seen[2]);   // each client sees its own time line
+        CHECK(30ms == std::chrono::steady_clock::now() - start);
+
+    } // End section : queueing model clients
+
+    SECTION("system time") {
+        auto steadyStart = std::chrono::steady_clock::now();
+        FSeam::Clock::setSystemTime(std::chrono::system_clock::time_point(24h));
+        CHECK(std::chrono::system_clock::time_point(24h) == std::chrono::system_clock::now());
+        CHECK(steadyStart == std::chrono::steady_clock::now());
+
+    } // End section : system time
+
+    FSeam::Clock::enable(false);
+    CHECK(std::chrono::steady_clock::now() - realStart < 10s);
+
+} // End TestCase : Test virtual clock seam
+
+TEST_CASE("Test disabled clock seam") {
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(1ms);
+    CHECK(std::chrono::steady_clock::now() - start >= 1ms);
+
+} // End TestCase : Test disabled clock seam
@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <FSeam.hpp>
+
+namespace {
+    bool saveJournal(const char *path, const std::string &entry) {
+        int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+            return false;
+        bool written = ::write(fd, entry.data(), entry.size()) == static_cast<ssize_t>(entry.size());
+        bool synced = ::fsync(fd) == 0;
+        return (::close(fd) == 0) && written && synced;
+    }
+}
+
+TEST_CASE("Test file I/O seam") {
+    FSeam::MemoryFs::enable("/fseam/");
+
+    SECTION("Write and read in memory") {
+        REQUIRE(saveJournal("/fseam/journal", "first;"));
+        REQUIRE(saveJournal("/fseam/journal", "second;"));
+        CHECK("first;second;" == FSeam::MemoryFs::content("/fseam/journal"));
+
+        char buffer[16] = {};
+        int fd = ::open("/fseam/journal", O_RDONLY);
+        REQUIRE(fd >= 0);
+        CHECK(6 == ::read(fd, buffer, 6));
+        CHECK(std::string("first;") == buffer);
+        CHECK(7 == ::pread(fd, buffer, sizeof(buffer), 6));
+        CHECK(std::string("second;") == std::string(buffer, 7));
+        CHECK(13 == ::lseek(fd, 0, SEEK_END));
+        CHECK(0 == ::read(fd, buffer, sizeof(buffer)));
+        CHECK(-1 == ::write(fd, "x", 1));
+        CHECK(EBADF == errno);
+        CHECK(0 == ::close(fd));
+
+    } // End section : Write and read in memory
+
+    SECTION("Syscalls verified per file") {
+        FSeam::MemoryFs::add("/fseam/other", "content");
+        REQUIRE(saveJournal("/fseam/journal", "entry;"));
+        REQUIRE(saveJournal("/fseam/journal", "entry;"));
+
+        auto journal = FSeam::MemoryFs::file("/fseam/journal");
+        CHECK(journal->verify(FSeam::MemoryFile::open::NAME, 2));
+        CHECK(journal->verify(FSeam::MemoryFile::write::NAME, 2));
+        CHECK(journal->verify(FSeam::MemoryFile::fsync::NAME, 2));
+        CHECK(journal->verify(FSeam::MemoryFile::close::NAME, 2));
+        CHECK(journal->verify(FSeam::MemoryFile::read::NAME, FSeam::NeverCalled{}));
+        CHECK(FSeam::MemoryFs::file("/fseam/other")->verify(FSeam::MemoryFile::open::NAME, FSeam::NeverCalled{}));
+        CHECK(FSeam::MemoryFs::all()->verify(FSeam::MemoryFile::fsync::NAME, 2));
+
+    } // End section : Syscalls verified per file
+
+    SECTION("Missing file and error injection") {
+        CHECK(-1 == ::open("/fseam/missing", O_RDONLY));
+        CHECK(ENOENT == errno);
+
+        FSeam::MemoryFs::file("/fseam/journal")->dupeMethod(FSeam::MemoryFile::fsync::NAME, [](void *data) {
+            static_cast<FSeam::MemoryFs::Data *>(data)->error = EIO;
+        });
+        CHECK_FALSE(saveJournal("/fseam/journal", "entry;"));
+        CHECK(FSeam::MemoryFs::file("/fseam/journal")->verify(FSeam::MemoryFile::fsync::NAME, 1));
+
+    } // End section : Missing file and error injection
+
+    SECTION("Injected latency") {
+        std::chrono::nanoseconds delayed {0};
+        FSeam::Latency::onDelay([&delayed](std::chrono::nanoseconds delay) { delayed += delay; });
+        FSeam::MemoryFs::all()->dupeLatency<FSeam::MemoryFile::fsync>(FSeam::Latency::Fixed{std::chrono::milliseconds(5)});
+
+        REQUIRE(saveJournal("/fseam/journal", "entry;"));
+        REQUIRE(saveJournal("/fseam/other", "entry;"));
+        CHECK(std::chrono::milliseconds(10) == delayed);
+        FSeam::Latency::onDelay(std::function<void(std::chrono::nanoseconds)>{});
+
+    } // End section : Injected latency
+
+    SECTION("Paths outside of the root are forwarded") {
+        int fd = ::open("/dev/null", O_WRONLY);
+        REQUIRE(fd >= 0);
+        CHECK(4 == ::write(fd, "real", 4));
+        CHECK(0 == ::close(fd));
+        CHECK(FSeam::MemoryFs::all()->verify(FSeam::MemoryFile::open::NAME, FSeam::NeverCalled{}));
+
+    } // End section : Paths outside of the root are forwarded
+
+    SECTION("Root matched per path component") {
+        CHECK(FSeam::MemoryFs::isManaged("/fseam"));
+        CHECK(FSeam::MemoryFs::isManaged("/fseam/journal"));
+        CHECK_FALSE(FSeam::MemoryFs::isManaged("/fseam-backup/journal"));
+        FSeam::MemoryFs::enable("/tmp/db");
+        CHECK(FSeam::MemoryFs::isManaged("/tmp/db/wal"));
+        CHECK_FALSE(FSeam::MemoryFs::isManaged("/tmp/db-backup/wal"));
+        FSeam::MemoryFs::enable("/");
+        CHECK(FSeam::MemoryFs::isManaged("/tmp/db-backup/wal"));
+
+    } // End section : Root matched per path component
+
+    FSeam::MemoryFs::enable("/", false);
+    FSeam::MemoryFs::reset();
+    FSeam::MockVerifier::cleanUp();
+}
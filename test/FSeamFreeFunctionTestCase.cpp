@@ -105,5 +105,10 @@ TEST_CASE("Test FreeFunction") {
 
     } // End section : Argument expectation
 
+    SECTION("Metrics binary name is not truncated") {
+        CHECK("testFSeamFreeFunction" == FSeam::Metrics::internal::binaryName());
+
+    } // End section : Metrics binary name is not truncated
+
     FSeam::MockVerifier::cleanUp();
 } // End TestCase : Test FreeFunction
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test latency injection") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    std::vector<std::chrono::nanoseconds> delays;
+    FSeam::Latency::onDelay([&delays](std::chrono::nanoseconds delay) { delays.emplace_back(delay); });
+    FSeam::Latency::setSeed(42);
+
+    SECTION("Fixed") {
+        fseamMock->dupeLatency<FSeam::DependencyGettable::checkCalled>(FSeam::Latency::Fixed{30s});
+        testingClass.execute();
+        testingClass.execute();
+        REQUIRE(2 == delays.size());
+        CHECK(30s == delays.front());
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 2));
+
+    } // End section : Fixed
+
+    SECTION("Composed with dupeReturn") {
+        fseamMock->dupeReturn<FSeam::DependencyGettable::checkSimpleReturnValue>(42);
+        fseamMock->dupeLatency<FSeam::DependencyGettable::checkSimpleReturnValue>(FSeam::Latency::Fixed{10ms});
+        CHECK(42 == testingClass.getDepGettable().checkSimpleReturnValue());
+        REQUIRE(1 == delays.size());
+
+    } // End section : Composed with dupeReturn
+
+    SECTION("Uniform and empirical bounds") {
+        fseamMock->dupeLatency<FSeam::DependencyGettable::checkCalled>(FSeam::Latency::Uniform{1ms, 2ms});
+        fseamMock->dupeLatency<FSeam::DependencyGettable::checkSimpleReturnValue>(
+                FSeam::Latency::Empirical{{{5ms, 0.}, {10ms, 1.}}});
+        for (int i = 0; i < 100; ++i) {
+            testingClass.getDepGettable().checkCalled();
+            CHECK(delays.back() >= 1ms);
+            CHECK(delays.back() <= 2ms);
+            testingClass.getDepGettable().checkSimpleReturnValue();
+            CHECK(delays.back() >= 5ms);
+            CHECK(delays.back() <= 10ms);
+        }
+
+    } // End section : Uniform and empirical bounds
+
+    SECTION("Non positive log-normal median") {
+        CHECK_THROWS_AS(FSeam::Latency::LogNormal(0ms, 0.5), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::LogNormal(-1ms), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::LogNormal(1ms, 0.), std::invalid_argument);
+
+    } // End section : Non positive log-normal median
+
+    SECTION("Invalid uniform bounds") {
+        CHECK_THROWS_AS(FSeam::Latency::Uniform(2ms, 1ms), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Uniform(-1ms, 1ms), std::invalid_argument);
+        CHECK_NOTHROW(FSeam::Latency::Uniform(1ms, 1ms));
+
+    } // End section : Invalid uniform bounds
+
+    SECTION("Invalid empirical buckets") {
+        using Buckets = std::vector<FSeam::Latency::Empirical::Bucket>;
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{}), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{{10ms, 1.}, {5ms, 1.}}), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{{5ms, 1.}, {5ms, 1.}}), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{{-1ms, 1.}}), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{{5ms, -1.}, {10ms, 2.}}), std::invalid_argument);
+        CHECK_THROWS_AS(FSeam::Latency::Empirical(Buckets{{5ms, 0.}}), std::invalid_argument);
+        CHECK_NOTHROW(FSeam::Latency::Empirical(Buckets{{0ms, 1.}, {5ms, 0.}}));
+
+    } // End section : Invalid empirical buckets
+
+    SECTION("Reproducible sampling") {
+        fseamMock->dupeLatency<FSeam::DependencyGettable::checkCalled>(FSeam::Latency::LogNormal{20ms, 0.5});
+        for (int i = 0; i < 10; ++i)
+            testingClass.getDepGettable().checkCalled();
+        std::vector<std::chrono::nanoseconds> firstRun = std::move(delays);
+
+        delays.clear();
+        FSeam::Latency::setSeed(42);
+        for (int i = 0; i < 10; ++i)
+            testingClass.getDepGettable().checkCalled();
+        CHECK(firstRun == delays);
+
+    } // End section : Reproducible sampling
+
+    FSeam::Latency::onDelay(std::function<void(std::chrono::nanoseconds)>{});
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test latency injection
+
+TEST_CASE("Test latency injection blocking") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    fseamMock->dupeLatency<FSeam::DependencyGettable::checkCalled>(FSeam::Latency::Fixed{2ms});
+
+    auto start = std::chrono::steady_clock::now();
+    testingClass.getDepGettable().checkCalled();
+    CHECK(std::chrono::steady_clock::now() - start >= 2ms);
+
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test latency injection blocking
@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <FSeam.hpp>
+
+namespace {
+    struct Batch {
+        void addPerItem(const std::vector<int> &items) {
+            for (int item : items) {
+                std::lock_guard<std::mutex> lock(mutex);
+                values.emplace_back(item);
+            }
+        }
+        void addAll(const std::vector<int> &items) {
+            std::lock_guard<std::mutex> lock(mutex);
+            values.insert(values.end(), items.begin(), items.end());
+        }
+        std::mutex mutex;
+        std::vector<int> values;
+    };
+}
+
+TEST_CASE("Test lock seam") {
+    Batch batch;
+    std::vector<int> items {1, 2, 3, 4};
+    batch.values.reserve(16);
+
+    SECTION("Lock budget") {
+        FSeam::LockScope::Counters counters;
+        {
+            FSeam::LockScope scope("batch");
+            batch.addAll(items);
+            counters = scope.counters();
+            CHECK(FSeam::verifyLocks(scope, FSeam::AtMost(1)));
+        }
+        CHECK(1 == counters.total.acquisitions);
+        CHECK(0 == counters.total.contended);
+        CHECK(1 == counters.of(&batch.mutex).acquisitions);
+
+    } // End section : Lock budget
+
+    SECTION("Lock per item regression") {
+        FSeam::LockScope scope("batch");
+        batch.addPerItem(items);
+        FSeam::LockScope::Counters counters = scope.counters();
+        CHECK(4 == counters.of(&batch.mutex).acquisitions);
+        CHECK_FALSE(FSeam::verifyLocks(scope, FSeam::AtMost(1), false));
+
+    } // End section : Lock per item regression
+
+    SECTION("Contention and hold time") {
+        FSeam::LockStats workerStats;
+        std::unique_lock<std::mutex> held(batch.mutex);
+        std::thread worker([&batch, &items, &workerStats]() {
+            FSeam::LockScope scope("worker");
+            batch.addAll(items);
+            workerStats = scope.counters().of(&batch.mutex);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            FSeam::LockScope scope("holder");
+            held.unlock();
+            CHECK(0 == scope.counters().total.acquisitions);
+        }
+        worker.join();
+        CHECK(1 == workerStats.acquisitions);
+        CHECK(1 == workerStats.contended);
+
+        FSeam::LockScope scope("hold time");
+        held.lock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        held.unlock();
+        CHECK(scope.counters().of(&batch.mutex).held >= std::chrono::milliseconds(5));
+
+    } // End section : Contention and hold time
+
+    SECTION("Condition variable") {
+        std::condition_variable condition;
+        bool ready = false;
+        FSeam::LockStats notifierStats;
+        std::thread notifier([&]() {
+            FSeam::LockScope scope("notifier");
+            {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                ready = true;
+            }
+            condition.notify_one();
+            notifierStats = scope.counters().of(&condition);
+        });
+        FSeam::LockScope scope("waiter");
+        {
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            condition.wait(lock, [&ready]() { return ready; });
+        }
+        notifier.join();
+        CHECK(ready);
+        CHECK(1 == notifierStats.signals);
+        CHECK(scope.counters().of(&condition).waits <= scope.counters().of(&batch.mutex).acquisitions);
+
+    } // End section : Condition variable
+
+    FSeam::MockVerifier::cleanUp();
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+TEST_CASE("Test buffered verify failures") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    FSeam::Logging::Logger::buffered(true, 2);
+
+    SECTION("Failures are recorded, not formatted") {
+        REQUIRE(FSeam::Logging::Logger::pending().empty());
+        CHECK_FALSE(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME));
+        REQUIRE(1 == FSeam::Logging::Logger::pending().size());
+
+        const auto &failure = FSeam::Logging::Logger::pending().records().front();
+        CHECK(failure.neverCalled);
+        CHECK(1 == failure.expected);
+        CHECK(0 == failure.received);
+        CHECK(std::string("DependencyGettablecheckCalled") == failure.key);
+
+        testingClass.execute();
+        CHECK_FALSE(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, FSeam::AtLeast{3}));
+        REQUIRE(2 == FSeam::Logging::Logger::pending().size());
+        CHECK(std::string("Verify error for method DependencyGettablecheckCalled, method has been called but "
+                          "we expected at least 3 method call but received 1 method call \n") ==
+              FSeam::Logging::Logger::pending().records().back().format());
+
+    } // End section : Failures are recorded, not formatted
+
+    SECTION("Bounded buffer") {
+        for (int i = 0; i < 10; ++i)
+            CHECK_FALSE(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 1));
+        CHECK(2 == FSeam::Logging::Logger::pending().size());
+        CHECK(8 == FSeam::Logging::Logger::pending().dropped());
+
+    } // End section : Bounded buffer
+
+    SECTION("Silent verify is not recorded") {
+        CHECK_FALSE(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, false));
+        CHECK(FSeam::Logging::Logger::pending().empty());
+
+    } // End section : Silent verify is not recorded
+
+    SECTION("Analysis failures are recorded") {
+        FSeam::report::enableRedundantCalls();
+        testingClass.execute();
+        testingClass.execute();
+        CHECK_FALSE(FSeam::report::verifyRedundantCalls(0.));
+        REQUIRE(2 == FSeam::Logging::Logger::pending().size()); // checkCalled and checkSimpleInputVariable
+
+        for (const auto &failure : FSeam::Logging::Logger::pending().records())
+            CHECK(0 == failure.format().find("Redundant calls for method " + failure.key + ", 1 of the 2 calls"));
+        FSeam::report::enableRedundantCalls(false);
+
+    } // End section : Analysis failures are recorded
+
+    FSeam::MockVerifier::cleanUp();
+    CHECK(FSeam::Logging::Logger::pending().empty());
+    FSeam::Logging::Logger::buffered(false);
+
+} // End TestCase : Test buffered verify failures
@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+namespace {
+    const FSeam::Metrics::MethodMetrics &find(const std::vector<FSeam::Metrics::MethodMetrics> &metrics,
+                                              const std::string &className, const std::string &methodName) {
+        auto it = std::find_if(metrics.begin(), metrics.end(), [&className, &methodName](const auto &method) {
+            return method.className == className && method.methodName == methodName;
+        });
+        REQUIRE(it != metrics.end());
+        return *it;
+    }
+
+    std::string read(const std::string &path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+TEST_CASE("Test metrics accumulated over cleanUp") {
+    FSeam::Metrics::reset();
+    FSeam::Metrics::enable(".");
+    {
+        source::TestingClass testingClass {};
+        auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+        fseamMock->expectArg<FSeam::DependencyGettable::checkSimpleInputVariable>(FSeam::Eq(42), FSeam::Any(), FSeam::AtLeast{1});
+        testingClass.execute();
+        FSeam::MockVerifier::cleanUp();
+    }
+    source::TestingClass testingClass {};
+    testingClass.execute();
+
+    SECTION("Snapshot") {
+        std::vector<FSeam::Metrics::MethodMetrics> metrics = FSeam::Metrics::snapshot();
+        const auto &input = find(metrics, "DependencyGettable", FSeam::DependencyGettable::checkSimpleInputVariable::NAME);
+        CHECK(2 == input.calls);
+        CHECK(1 == input.expectationHits);
+        CHECK(2 * (sizeof(int) + 4) == input.capturedBytes); // same count as the payload analysis
+        CHECK(2 == find(metrics, "DependencyNonGettable", FSeam::DependencyNonGettable::checkCalled::NAME).calls);
+        CHECK(0 == find(metrics, "DependencyNonGettable", FSeam::DependencyNonGettable::checkCalled::NAME).capturedBytes);
+
+    } // End section : Snapshot
+
+    SECTION("JSON") {
+        const std::string path = "fseam_metrics_test.json";
+        REQUIRE(FSeam::Metrics::write(path, FSeam::Metrics::Format::JSON, "testFSeam", "0"));
+        std::string content = read(path);
+        CHECK(content.find("{\"binary\":\"testFSeam\",\"shard\":\"0\",\"methods\":[") == 0);
+        CHECK(content.find("{\"class\":\"DependencyGettable\",\"method\":\"checkSimpleReturnValue\",\"calls\":2,\"expectationHits\":0,\"capturedBytes\":0}") != std::string::npos);
+        std::remove(path.c_str());
+
+    } // End section : JSON
+
+    SECTION("OpenMetrics") {
+        const std::string path = "fseam_metrics_test.prom";
+        REQUIRE(FSeam::Metrics::write(path, FSeam::Metrics::Format::OPEN_METRICS, "testFSeam", "0"));
+        std::string content = read(path);
+        CHECK(content.find("# TYPE fseam_mock_calls counter\n") == 0);
+        CHECK(content.find("fseam_mock_calls_total{binary=\"testFSeam\",shard=\"0\",class=\"DependencyGettable\",method=\"checkCalled\"} 2\n") != std::string::npos);
+        CHECK(content.find("fseam_mock_expectation_hits_total{binary=\"testFSeam\",shard=\"0\",class=\"DependencyGettable\",method=\"checkSimpleInputVariable\"} 1\n") != std::string::npos);
+        CHECK(content.rfind("# EOF\n") == content.size() - 6);
+        std::remove(path.c_str());
+
+    } // End section : OpenMetrics
+
+    FSeam::Metrics::enable("", FSeam::Metrics::Format::JSON, false);
+    FSeam::Metrics::reset();
+    FSeam::MockVerifier::cleanUp();
+}
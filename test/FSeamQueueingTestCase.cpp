@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test queueing model") {
+    source::TestingClass testingClass {};
+    auto &dependency = testingClass.getDepGettable();
+    auto fseamMock = FSeam::get(&dependency);
+    FSeam::Queueing::Model model;
+
+    SECTION("Saturated server") {
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10ms}, 1});
+        FSeam::Queueing::Result result = model.run(4, 5, [&dependency](std::size_t) { dependency.checkCalled(); });
+
+        REQUIRE(20 == result.latencies.size());
+        CHECK(200ms == result.duration);
+        CHECK(Approx(100.) == result.throughput());
+        CHECK(10ms == result.latencies.front());
+        CHECK(40ms == result.percentile(0.5));
+        CHECK(40ms == result.percentile(0.99));
+
+        const FSeam::Queueing::ServerReport &server = result.servers.at("DependencyGettablecheckCalled");
+        CHECK(20 == server.requests);
+        CHECK(19 == server.queued);
+        CHECK(30ms == server.maxQueueingDelay);
+        CHECK(Approx(1.) == server.utilization(result.duration));
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 20));
+
+    } // End section : Saturated server
+
+    SECTION("Concurrency limit") {
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10ms}, 2});
+        FSeam::Queueing::Result result = model.run(4, 5, [&dependency](std::size_t) { dependency.checkCalled(); });
+        CHECK(100ms == result.duration);
+        CHECK(20ms == result.percentile(0.99));
+
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10ms}, 4});
+        result = model.run(4, 5, [&dependency](std::size_t) { dependency.checkCalled(); });
+        CHECK(50ms == result.duration);
+        CHECK(10ms == result.percentile(0.99));
+        CHECK(0 == result.servers.at("DependencyGettablecheckCalled").queued);
+
+    } // End section : Concurrency limit
+
+    SECTION("Several servers and think time") {
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10ms}, 1});
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkSimpleReturnValue>(model, {FSeam::Latency::Fixed{5ms}, 8});
+        FSeam::Queueing::Result result = model.run(2, 3, [&dependency](std::size_t) {
+            dependency.checkSimpleReturnValue();
+            dependency.checkCalled();
+        }, FSeam::Latency::Fixed{100ms});
+
+        REQUIRE(6 == result.latencies.size());
+        CHECK(15ms == result.latencies.front());
+        CHECK(25ms == result.latencies.back());
+        CHECK(2 == result.servers.size());
+        CHECK(0 == result.servers.at("DependencyGettablecheckSimpleReturnValue").queued);
+
+    } // End section : Several servers and think time
+
+    SECTION("Reproducible run") {
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::LogNormal{10ms, 0.5}, 3});
+        auto request = [&dependency](std::size_t) { dependency.checkCalled(); };
+        FSeam::Queueing::Result first = model.run(8, 20, request);
+        FSeam::Queueing::Result second = model.run(8, 20, request);
+
+        CHECK(160 == first.latencies.size());
+        CHECK(first.latencies == second.latencies);
+        CHECK(first.duration == second.duration);
+
+    } // End section : Reproducible run
+
+    SECTION("Outside of a run") {
+        fseamMock->dupeServer<FSeam::DependencyGettable::checkCalled>(model, {FSeam::Latency::Fixed{10s}, 1});
+        auto start = std::chrono::steady_clock::now();
+        dependency.checkCalled();
+        CHECK(std::chrono::steady_clock::now() - start < 1s);
+
+    } // End section : Outside of a run
+
+    FSeam::MockVerifier::cleanUp();
+
+} // End TestCase : Test queueing model
@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+namespace {
+    std::string encodeInt(int value) {
+        std::string encoded;
+        FSeam::Record::Codec<int>::encode(encoded, value);
+        return encoded;
+    }
+}
+
+TEST_CASE("Test replay of recorded calls") {
+    const std::string path = "fseam_replay_test.fseamrec";
+    std::remove(path.c_str());
+    {
+        FSeam::Record::Recorder recorder(path);
+        REQUIRE(recorder.good());
+        recorder.append("DependencyGettablecheckSimpleReturnValue", "", encodeInt(1));
+        recorder.append("DependencyGettablecheckCalled", "", "");
+        recorder.append("DependencyGettablecheckSimpleReturnValue", "", encodeInt(2));
+        CHECK(3 == recorder.recorded());
+    }
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    auto replayer = std::make_shared<FSeam::Record::Replayer>(path);
+    REQUIRE(replayer->good());
+    CHECK(3 == replayer->records());
+
+    SECTION("In order") {
+        fseamMock->dupeReturn<FSeam::DependencyGettable::checkSimpleReturnValue>(42);
+        fseamMock->replay<FSeam::DependencyGettable::checkSimpleReturnValue>(replayer);
+        CHECK(1 == testingClass.getDepGettable().checkSimpleReturnValue());
+        CHECK(2 == testingClass.getDepGettable().checkSimpleReturnValue());
+        CHECK(42 == testingClass.getDepGettable().checkSimpleReturnValue()); // no record left
+        CHECK(2 == replayer->served());
+        CHECK(1 == replayer->missed());
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkSimpleReturnValue::NAME, 3));
+
+    } // End section : In order
+
+    SECTION("Appended records") {
+        {
+            FSeam::Record::Recorder recorder(path);
+            recorder.append("DependencyGettablecheckSimpleReturnValue", "", encodeInt(3));
+        }
+        auto appended = std::make_shared<FSeam::Record::Replayer>(path);
+        CHECK(4 == appended->records());
+        fseamMock->replay<FSeam::DependencyGettable::checkSimpleReturnValue>(appended);
+        testingClass.getDepGettable().checkSimpleReturnValue();
+        testingClass.getDepGettable().checkSimpleReturnValue();
+        CHECK(3 == testingClass.getDepGettable().checkSimpleReturnValue());
+
+    } // End section : Appended records
+
+    SECTION("By arguments") {
+        {
+            FSeam::Record::Recorder recorder(path);
+            recorder.append("Keyed", *FSeam::Record::internal::encodeArgs(1, std::string("a")), encodeInt(10));
+            recorder.append("Keyed", *FSeam::Record::internal::encodeArgs(2, std::string("b")), encodeInt(20));
+            recorder.append("Keyed", *FSeam::Record::internal::encodeArgs(1, std::string("a")), encodeInt(11));
+        }
+        FSeam::Record::Replayer keyed(path);
+        auto served = keyed.next("Keyed", FSeam::Record::internal::encodeArgs(2, std::string("b")), FSeam::Record::Mode::BY_ARGS);
+        REQUIRE(served);
+        CHECK(encodeInt(20) == *served);
+        CHECK(encodeInt(10) == *keyed.next("Keyed", FSeam::Record::internal::encodeArgs(1, std::string("a")), FSeam::Record::Mode::BY_ARGS));
+        CHECK(encodeInt(11) == *keyed.next("Keyed", FSeam::Record::internal::encodeArgs(1, std::string("a")), FSeam::Record::Mode::BY_ARGS));
+        CHECK_FALSE(keyed.next("Keyed", FSeam::Record::internal::encodeArgs(1, std::string("a")), FSeam::Record::Mode::BY_ARGS));
+        CHECK_FALSE(keyed.next("Keyed", FSeam::Record::internal::encodeArgs(3, std::string("c")), FSeam::Record::Mode::BY_ARGS));
+
+    } // End section : By arguments
+
+    std::remove(path.c_str());
+    FSeam::MockVerifier::cleanUp();
+}
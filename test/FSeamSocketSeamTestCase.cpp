@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <FSeam.hpp>
+
+namespace {
+    struct sockaddr_in loopback(std::uint16_t port) {
+        struct sockaddr_in address {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+
+    int connectTo(std::uint16_t port, int type = SOCK_STREAM) {
+        struct sockaddr_in address = loopback(port);
+        int fd = ::socket(AF_INET, type, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0)
+            return -1;
+        return fd;
+    }
+
+    std::string receiveAll(int fd) {
+        std::string received;
+        char buffer[64];
+        ssize_t size;
+        while ((size = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+            received.append(buffer, static_cast<std::size_t>(size));
+        return received;
+    }
+}
+
+TEST_CASE("Test socket seam") {
+    FSeam::Network::enable();
+    FSeam::Network::listen("127.0.0.1:8080", [](std::string_view received) { return "echo:" + std::string(received); });
+
+    SECTION("Stream through the stand-in") {
+        int fd = connectTo(8080);
+        REQUIRE(fd >= 0);
+        CHECK(5 == ::send(fd, "hello", 5, 0));
+        CHECK("echo:hello" == receiveAll(fd)); // nothing left, the blocking recv sees the end of the stream
+        CHECK(0 == ::close(fd));
+
+        FSeam::Network::Traffic traffic = FSeam::Network::traffic("127.0.0.1:8080");
+        CHECK(1 == traffic.connections);
+        CHECK(5 == traffic.sent);
+        CHECK(10 == traffic.received);
+
+    } // End section : Stream through the stand-in
+
+    SECTION("Non blocking receive") {
+        int fd = connectTo(8080, SOCK_STREAM | SOCK_NONBLOCK);
+        REQUIRE(fd >= 0);
+        char buffer[16];
+        CHECK(-1 == ::recv(fd, buffer, sizeof(buffer), 0));
+        CHECK(EAGAIN == errno);
+        CHECK(0 == ::close(fd));
+
+        fd = connectTo(8080);
+        REQUIRE(fd >= 0);
+        CHECK(-1 == ::recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT));
+        CHECK(EAGAIN == errno);
+        CHECK(0 == ::recv(fd, buffer, sizeof(buffer), 0));
+        CHECK(0 == ::close(fd));
+
+    } // End section : Non blocking receive
+
+    SECTION("Calls verified per stand-in") {
+        int fd = connectTo(8080);
+        REQUIRE(fd >= 0);
+        ::send(fd, "a", 1, 0);
+        ::send(fd, "b", 1, 0);
+        receiveAll(fd);
+        ::close(fd);
+
+        auto server = FSeam::Network::server("127.0.0.1:8080");
+        CHECK(server->verify(FSeam::Socket::connect::NAME, 1));
+        CHECK(server->verify(FSeam::Socket::send::NAME, 2));
+        CHECK(server->verify(FSeam::Socket::recv::NAME, 2));
+        CHECK(FSeam::Network::all()->verify(FSeam::Socket::socket::NAME, 1));
+        CHECK(-1 == connectTo(9090));
+        CHECK(ECONNREFUSED == errno);
+
+    } // End section : Calls verified per stand-in
+
+    SECTION("Segments, bandwidth and latency") {
+        std::chrono::nanoseconds delayed {0};
+        FSeam::Latency::onDelay([&delayed](std::chrono::nanoseconds delay) { delayed += delay; });
+        FSeam::Network::Link link;
+        link.bandwidth = 1000;
+        link.latency = FSeam::Latency::Fixed{std::chrono::milliseconds(2)};
+        link.segmentSize = 4;
+        FSeam::Network::listen("[::1]:7000", [](std::string_view) { return std::string(10, 'x'); }, link);
+
+        struct sockaddr_in6 address {};
+        address.sin6_family = AF_INET6;
+        address.sin6_port = htons(7000);
+        address.sin6_addr = in6addr_loopback;
+        int fd = ::socket(AF_INET6, SOCK_STREAM, 0);
+        REQUIRE(0 == ::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)));
+        CHECK(100 == ::send(fd, std::string(100, 'r').data(), 100, 0));
+        CHECK(std::chrono::milliseconds(102) == delayed);
+        CHECK(std::string(10, 'x') == receiveAll(fd));
+        CHECK(FSeam::Network::server("[::1]:7000")->verify(FSeam::Socket::recv::NAME, 4));
+        ::close(fd);
+        FSeam::Latency::onDelay(std::function<void(std::chrono::nanoseconds)>{});
+
+    } // End section : Segments, bandwidth and latency
+
+    SECTION("Datagrams and epoll") {
+        struct sockaddr_in address = loopback(8080);
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        int epfd = ::epoll_create1(0);
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        REQUIRE(0 == ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event));
+
+        struct epoll_event ready[4];
+        CHECK(0 == ::epoll_wait(epfd, ready, 4, 0));
+        CHECK(4 == ::sendto(fd, "ping", 4, 0, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)));
+        REQUIRE(1 == ::epoll_wait(epfd, ready, 4, 0));
+        CHECK(fd == ready[0].data.fd);
+
+        char buffer[32] = {};
+        struct sockaddr_in source {};
+        socklen_t sourceLength = sizeof(source);
+        CHECK(9 == ::recvfrom(fd, buffer, sizeof(buffer), 0, reinterpret_cast<struct sockaddr *>(&source), &sourceLength));
+        CHECK(std::string("echo:ping") == buffer);
+        CHECK(htons(8080) == source.sin_port);
+        CHECK(FSeam::Network::all()->verify(FSeam::Socket::epoll_wait::NAME, 2));
+        ::close(fd);
+        ::close(epfd);
+
+    } // End section : Datagrams and epoll
+
+    SECTION("Error injection") {
+        FSeam::Network::server("127.0.0.1:8080")->dupeMethod(FSeam::Socket::send::NAME, [](void *data) {
+            static_cast<FSeam::Network::Data *>(data)->error = ECONNRESET;
+        });
+        int fd = connectTo(8080);
+        CHECK(-1 == ::send(fd, "lost", 4, 0));
+        CHECK(ECONNRESET == errno);
+        CHECK(0 == FSeam::Network::traffic("127.0.0.1:8080").sent);
+        ::close(fd);
+
+    } // End section : Error injection
+
+    SECTION("Local sockets are forwarded") {
+        int pair[2];
+        REQUIRE(0 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+        CHECK(4 == ::send(pair[0], "real", 4, 0));
+        char buffer[4];
+        CHECK(4 == ::recv(pair[1], buffer, sizeof(buffer), 0));
+        ::close(pair[0]);
+        ::close(pair[1]);
+        CHECK(FSeam::Network::all()->verify(FSeam::Socket::send::NAME, FSeam::NeverCalled{}));
+
+    } // End section : Local sockets are forwarded
+
+    FSeam::Network::enable(false);
+    FSeam::Network::reset();
+    FSeam::MockVerifier::cleanUp();
+}
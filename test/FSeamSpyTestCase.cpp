@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+TEST_CASE("Test spy forwarding to the original implementation") {
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+
+    SECTION("Original behavior is kept") {
+        CHECK_FALSE(testingClass.getDepGettable().hasOriginalServiceBeenCalled());
+        CHECK(888 == testingClass.getDepGettable().checkSimpleReturnValue());
+        CHECK(testingClass.getDepGettable().hasOriginalServiceBeenCalled());
+        source::StructTest result = testingClass.getDepGettable().checkCustomStructReturnValue();
+        CHECK(888 == result.testInt);
+        CHECK("tttt" == result.testStr);
+
+    } // End section : Original behavior is kept
+
+    SECTION("Calls are recorded") {
+        fseamMock->expectArg<FSeam::DependencyGettable::checkSimpleInputVariable>(FSeam::Eq(42), FSeam::Eq(std::string("4242")), FSeam::VerifyCompare{2});
+        testingClass.execute();
+        testingClass.execute();
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCalled::NAME, 2));
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkSimpleReturnValue::NAME, 2));
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkSimpleInputVariable::NAME));
+        CHECK(fseamMock->verify(FSeam::DependencyGettable::checkCustomStructInputVariable::NAME, FSeam::NeverCalled{}));
+
+    } // End section : Calls are recorded
+
+    SECTION("Original return value given to the call data") {
+        fseamMock->setCost<FSeam::DependencyGettable::checkSimpleReturnValue>([](void *data) {
+            return static_cast<double>(static_cast<FSeam::DependencyGettableData *>(data)->checkSimpleReturnValue_ReturnValue);
+        });
+        FSeam::Scope scope("spy");
+        CHECK(888 == testingClass.getDepGettable().checkSimpleReturnValue());
+        CHECK(888. == scope.cost());
+
+    } // End section : Original return value given to the call data
+
+    SECTION("Duration report") {
+        testingClass.execute();
+        FSeam::report::SpyCall spy = fseamMock->spyCalls(FSeam::DependencyGettable::checkSimpleReturnValue::NAME);
+        CHECK(1 == spy.calls);
+        CHECK(spy.max <= spy.total);
+        CHECK(spy.total == spy.mean());
+        CHECK(0 == fseamMock->spyCalls(FSeam::DependencyGettable::checkCustomStructInputVariable::NAME).calls);
+
+        std::vector<FSeam::report::SpyCall> reports = FSeam::report::spyCalls();
+        CHECK(3 == reports.size());
+        for (std::size_t i = 1; i < reports.size(); ++i)
+            CHECK(reports.at(i - 1).total >= reports.at(i).total);
+
+    } // End section : Duration report
+
+    SECTION("Record the original responses") {
+        const std::string path = "fseam_spy_record_test.fseamrec";
+        std::remove(path.c_str());
+        auto recorder = std::make_shared<FSeam::Record::Recorder>(path);
+        fseamMock->record<FSeam::DependencyGettable::checkSimpleReturnValue>(recorder);
+        testingClass.execute();
+        testingClass.execute();
+        CHECK(2 == recorder->recorded());
+        recorder->flush();
+
+        FSeam::Record::Replayer replayer(path);
+        REQUIRE(2 == replayer.records());
+        int replayed = 0;
+        auto served = replayer.next("DependencyGettablecheckSimpleReturnValue", std::nullopt, FSeam::Record::Mode::IN_ORDER);
+        REQUIRE(served);
+        CHECK(FSeam::Record::Codec<int>::decode(*served, replayed));
+        CHECK(888 == replayed);
+        std::remove(path.c_str());
+
+    } // End section : Record the original responses
+
+    SECTION("Duped method is invoked before the original") {
+        bool duped = false;
+        fseamMock->dupeMethod(FSeam::DependencyGettable::checkCalled::NAME, [&duped](void *) { duped = true; });
+        testingClass.getDepGettable().checkCalled();
+        CHECK(duped);
+        CHECK(testingClass.getDepGettable().hasOriginalServiceBeenCalled());
+
+    } // End section : Duped method is invoked before the original
+
+    FSeam::MockVerifier::cleanUp();
+}
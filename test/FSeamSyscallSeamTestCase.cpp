@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <FSeam.hpp>
+
+namespace {
+    void flushRecords(int fd, const std::vector<std::string> &records, bool syncEachRecord) {
+        for (const auto &record : records) {
+            ::write(fd, record.data(), record.size());
+            if (syncEachRecord)
+                ::fsync(fd);
+        }
+        if (!syncEachRecord)
+            ::fsync(fd);
+    }
+}
+
+TEST_CASE("Test syscall seam") {
+    std::vector<std::string> records {"first;", "second;", "third;"};
+    int fd = ::open("/dev/null", O_WRONLY);
+    REQUIRE(fd >= 0);
+
+    SECTION("Syscall budget") {
+        FSeam::SyscallScope scope("batch flush");
+        flushRecords(fd, records, false);
+        FSeam::SyscallCount writes = scope.counters()[FSeam::Syscall::WRITE];
+        CHECK(3 == writes.calls);
+        CHECK(19 == writes.bytes);
+        CHECK(FSeam::verifySyscalls(scope, {{"fsync", FSeam::AtMost(1)}, {"write", FSeam::AtMost(4)}}));
+
+    } // End section : Syscall budget
+
+    SECTION("Syscall budget exceeded") {
+        FSeam::SyscallScope scope("per record flush");
+        flushRecords(fd, records, true);
+        CHECK(3 == scope.counters()[FSeam::Syscall::FSYNC].calls);
+        CHECK_FALSE(FSeam::verifySyscalls(scope, {{"fsync", FSeam::AtMost(1)}}, false));
+        CHECK_FALSE(FSeam::verifySyscalls(scope, {{"futex", FSeam::AtMost(1)}}, false));
+
+    } // End section : Syscall budget exceeded
+
+    SECTION("Nested scopes") {
+        FSeam::SyscallScope outer("outer");
+        std::size_t threadCalls = FSeam::SyscallScope::thread()[FSeam::Syscall::CLOCK_GETTIME].calls;
+        {
+            FSeam::SyscallScope inner("inner");
+            std::chrono::steady_clock::now();
+            void *mapped = ::mmap(nullptr, 4096, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            REQUIRE(MAP_FAILED != mapped);
+            ::munmap(mapped, 4096);
+            CHECK(FSeam::verifySyscalls(inner, {{"clock_gettime", FSeam::VerifyCompare{1}}, {"mmap", FSeam::VerifyCompare{1}}}));
+        }
+        CHECK(1 == outer.counters()[FSeam::Syscall::CLOCK_GETTIME].calls);
+        CHECK(4096 == outer.counters()[FSeam::Syscall::MMAP].bytes);
+        CHECK(threadCalls + 1 == FSeam::SyscallScope::thread()[FSeam::Syscall::CLOCK_GETTIME].calls);
+
+    } // End section : Nested scopes
+
+    ::close(fd);
+    FSeam::MockVerifier::cleanUp();
+}
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <catch2/catch.hpp>
+#include <TestingClass.hh>
+#include <FSeamMockData.hpp>
+
+TEST_CASE("Test trace of the mocked calls") {
+    using namespace std::chrono_literals;
+    source::TestingClass testingClass {};
+    auto fseamMock = FSeam::get(&testingClass.getDepGettable());
+    FSeam::Trace::clear();
+    FSeam::Trace::enable();
+
+    SECTION("Events per thread") {
+        fseamMock->dupeMethod(FSeam::DependencyGettable::checkCalled::NAME, [](void *) { std::this_thread::sleep_for(2ms); });
+        testingClass.getDepGettable().checkCalled();
+        std::thread([&testingClass]() { testingClass.getDepGettable().checkSimpleReturnValue(); }).join();
+
+        auto events = FSeam::Trace::events();
+        REQUIRE(2 == events.size());
+        auto checkCalled = std::find_if(events.begin(), events.end(), [](const auto &event) {
+            return event.second.methodName == FSeam::DependencyGettable::checkCalled::NAME;
+        });
+        auto checkSimpleReturnValue = std::find_if(events.begin(), events.end(), [](const auto &event) {
+            return event.second.methodName == FSeam::DependencyGettable::checkSimpleReturnValue::NAME;
+        });
+        REQUIRE(checkCalled != events.end());
+        REQUIRE(checkSimpleReturnValue != events.end());
+        CHECK("DependencyGettable" == checkCalled->second.className);
+        CHECK(checkCalled->first != checkSimpleReturnValue->first);
+        CHECK(checkCalled->second.handler >= 2ms);
+        CHECK(checkCalled->second.duration >= checkCalled->second.handler);
+        CHECK(checkCalled->second.start < checkSimpleReturnValue->second.start);
+
+    } // End section : Events per thread
+
+    SECTION("Chrome trace-event file") {
+        const std::string path = "fseam_trace_test.json";
+        testingClass.execute();
+        REQUIRE(FSeam::Trace::write(path));
+
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        CHECK(content.str().find("\"traceEvents\":[") != std::string::npos);
+        CHECK(content.str().find("{\"name\":\"checkSimpleInputVariable\",\"cat\":\"DependencyGettable\",\"ph\":\"X\"") != std::string::npos);
+        CHECK(content.str().find("\"cat\":\"DependencyNonGettable\"") != std::string::npos);
+        std::remove(path.c_str());
+
+    } // End section : Chrome trace-event file
+
+    SECTION("Disabled") {
+        FSeam::Trace::enable("", false);
+        testingClass.execute();
+        CHECK(FSeam::Trace::events().empty());
+
+    } // End section : Disabled
+
+    FSeam::Trace::enable("", false);
+    FSeam::Trace::clear();
+    FSeam::MockVerifier::cleanUp();
+}
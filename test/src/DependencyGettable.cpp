@@ -38,6 +38,13 @@ source::StructTest source::DependencyGettable::checkCustomStructReturnValue()  {
     return source::StructTest {888, 999, "tttt"};
 }
 
+source::StructTest &source::DependencyGettable::checkCustomStructReturnValueRef() {
+    static source::StructTest structTest {888, 999, "tttt"};
+    std::cout << "Original " << __func__ << " called returning {888,999,'tttt'}\n";
+    _hasOriginalBeenCalled = true;
+    return structTest;
+}
+
 void source::DependencyGettable::checkCustomStructInputVariableRef(const source::StructTest &testStr) {
     std::cout << "Original " << __func__ << " called\n";
     _hasOriginalBeenCalled = true;